@@ -0,0 +1,515 @@
+#pragma once
+
+#include "big_number.h"
+
+#include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace BigNumber {
+
+    // Chunk count up to which fixed size kernels are unrolled at compile time
+    const size_t FIXED_UNROLL_LIMIT = 8;
+
+    template <size_t Count, typename F>
+    constexpr void for_each_chunk(F&& f) {
+        if constexpr (Count <= FIXED_UNROLL_LIMIT) {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                (f(I), ...);
+            }(std::make_index_sequence<Count>{});
+        } else {
+            for (size_t i = 0; i < Count; ++i)
+                f(i);
+        }
+    }
+
+    // Number of N chunks precision fixed at compile time,
+    // number = (-1)^sign * (2^64)^exponent * mantissa with the same truncation rules as BigNumber
+    template <size_t N>
+    class BigFixed {
+        static_assert(N > 0, "BigFixed needs at least one chunk");
+
+     private:
+        uint64_t sign = 0;
+        int64_t exponent = 0;
+        std::array<uint64_t, N> mantissa = {};
+
+        template <size_t>
+        friend class BigFixed;
+
+        static constexpr BigFixed from_chunks(const uint64_t *chunks, size_t size, int64_t exponent, uint64_t sign) {
+            // Drops low zero chunks and keeps the highest N, like VectorUtils::normalise_mantissa
+            size_t high = size;
+            while (high > 0 && chunks[high - 1] == 0)
+                --high;
+            if (high == 0)
+                return BigFixed();
+            size_t low = 0;
+            while (chunks[low] == 0)
+                ++low;
+            const size_t start = std::max(low, high > N ? high - N : 0);
+            BigFixed result;
+            result.sign = sign;
+            result.exponent = exponent + static_cast<int64_t>(start);
+            for (size_t i = start; i < high; ++i)
+                result.mantissa[i - start] = chunks[i];
+            return result;
+        }
+
+        [[nodiscard]] constexpr size_t high_chunk() const {
+            // Index of the highest non zero chunk, number is not zero
+            size_t high = N - 1;
+            while (mantissa[high] == 0)
+                --high;
+            return high;
+        }
+
+        [[nodiscard]] constexpr int64_t top() const {
+            return exponent + static_cast<int64_t>(high_chunk());
+        }
+
+        [[nodiscard]] constexpr uint64_t chunk_at(int64_t position) const {
+            const int64_t index = position - exponent;
+            return index >= 0 && index < static_cast<int64_t>(N) ? mantissa[index] : 0;
+        }
+
+        static constexpr std::strong_ordering compare_magnitudes(const BigFixed& lhs, const BigFixed& rhs) {
+            if (lhs.is_zero() || rhs.is_zero())
+                return !lhs.is_zero() <=> !rhs.is_zero();
+            const int64_t top = lhs.top();
+            if (top != rhs.top())
+                return top <=> rhs.top();
+            for (int64_t position = top; position > top - static_cast<int64_t>(N); --position) {
+                const uint64_t lhs_chunk = lhs.chunk_at(position);
+                const uint64_t rhs_chunk = rhs.chunk_at(position);
+                if (lhs_chunk != rhs_chunk)
+                    return lhs_chunk <=> rhs_chunk;
+            }
+            return std::strong_ordering::equal;
+        }
+
+        static constexpr BigFixed add(const BigFixed& lhs, const BigFixed& rhs, bool negate) {
+            if (rhs.is_zero())
+                return lhs;
+            BigFixed summand = rhs;
+            summand.sign ^= negate;
+            if (lhs.is_zero())
+                return summand;
+            const bool lhs_higher = lhs.top() >= rhs.top();
+            const BigFixed& higher = lhs_higher ? lhs : summand;
+            const BigFixed& lower = lhs_higher ? summand : lhs;
+
+            // Window of 2N + 2 chunks with a carry chunk on top. Whatever lies below the window only
+            // matters as non zero, so it is folded into the lowest chunk, far below the kept N chunks
+            const int64_t bottom = higher.top() - static_cast<int64_t>(2 * N);
+            std::array<uint64_t, 2 * N + 2> high_chunks = {};
+            std::array<uint64_t, 2 * N + 2> low_chunks = {};
+            // Zero chunks are skipped, they may lie above the window
+            for_each_chunk<N>([&](size_t i) {
+                if (higher.mantissa[i] != 0)
+                    high_chunks[higher.exponent + static_cast<int64_t>(i) - bottom] = higher.mantissa[i];
+            });
+            bool below = false;
+            for_each_chunk<N>([&](size_t i) {
+                const int64_t position = lower.exponent + static_cast<int64_t>(i);
+                if (lower.mantissa[i] == 0)
+                    return;
+                if (position >= bottom)
+                    low_chunks[position - bottom] = lower.mantissa[i];
+                else
+                    below = true;
+            });
+            if (below)
+                low_chunks[0] = 1;
+
+            uint64_t result_sign = higher.sign;
+            if (higher.sign == lower.sign) {
+                uint64_t carry = 0;
+                for_each_chunk<2 * N + 2>([&](size_t i) {
+                    const __uint128_t sum = static_cast<__uint128_t>(high_chunks[i]) + low_chunks[i] + carry;
+                    high_chunks[i] = static_cast<uint64_t>(sum);
+                    carry = static_cast<uint64_t>(sum >> 64);
+                });
+            } else {
+                bool swapped = false;
+                for (size_t i = 2 * N + 2; i-- > 0;) {
+                    if (high_chunks[i] != low_chunks[i]) {
+                        swapped = high_chunks[i] < low_chunks[i];
+                        break;
+                    }
+                }
+                if (swapped) {
+                    std::swap(high_chunks, low_chunks);
+                    result_sign = lower.sign;
+                }
+                uint64_t borrow = 0;
+                for_each_chunk<2 * N + 2>([&](size_t i) {
+                    const uint64_t difference = high_chunks[i] - low_chunks[i] - borrow;
+                    borrow = high_chunks[i] < low_chunks[i] || high_chunks[i] - low_chunks[i] < borrow;
+                    high_chunks[i] = difference;
+                });
+            }
+            return from_chunks(high_chunks.data(), high_chunks.size(), bottom, result_sign);
+        }
+
+        static void multiply_vectors(const BigFixed& lhs, const BigFixed& rhs, std::array<uint64_t, 2 * N>& product) {
+            // Large runtime products go through the Karatsuba, Toom and NTT tiers
+            const VectorUtils::ChunkVector result = VectorUtils::multiply_vectors(
+                VectorUtils::ChunkVector(lhs.mantissa.begin(), lhs.mantissa.end()),
+                VectorUtils::ChunkVector(rhs.mantissa.begin(), rhs.mantissa.end()));
+            std::copy(result.begin(), result.end(), product.begin());
+        }
+
+        static constexpr BigFixed multiply(const BigFixed& lhs, const BigFixed& rhs) {
+            std::array<uint64_t, 2 * N> product = {};
+            if (!std::is_constant_evaluated() && N >= VectorUtils::KARATSUBA_THRESHOLD) {
+                multiply_vectors(lhs, rhs, product);
+            } else {
+                for_each_chunk<N>([&](size_t i) {
+                    uint64_t carry = 0;
+                    for_each_chunk<N>([&](size_t j) {
+                        const __uint128_t chunk = static_cast<__uint128_t>(lhs.mantissa[i]) * rhs.mantissa[j]
+                                                  + product[i + j] + carry;
+                        product[i + j] = static_cast<uint64_t>(chunk);
+                        carry = static_cast<uint64_t>(chunk >> 64);
+                    });
+                    product[i + N] = carry;
+                });
+            }
+            return from_chunks(product.data(), product.size(), lhs.exponent + rhs.exponent, lhs.sign != rhs.sign);
+        }
+
+        static void square_vector(const BigFixed& number, std::array<uint64_t, 2 * N>& product) {
+            const VectorUtils::ChunkVector result = VectorUtils::square_vector(
+                VectorUtils::ChunkVector(number.mantissa.begin(), number.mantissa.end()));
+            std::copy(result.begin(), result.end(), product.begin());
+        }
+
+        static constexpr BigFixed square(const BigFixed& number) {
+            std::array<uint64_t, 2 * N> product = {};
+            if (!std::is_constant_evaluated() && N >= VectorUtils::KARATSUBA_THRESHOLD) {
+                square_vector(number, product);
+            } else {
+                // Products of distinct chunks once, doubled, then squares of chunks
+                for (size_t i = 0; i + 1 < N; ++i) {
+                    uint64_t carry = 0;
+                    for (size_t j = i + 1; j < N; ++j) {
+                        const __uint128_t chunk = static_cast<__uint128_t>(number.mantissa[i]) * number.mantissa[j]
+                                                  + product[i + j] + carry;
+                        product[i + j] = static_cast<uint64_t>(chunk);
+                        carry = static_cast<uint64_t>(chunk >> 64);
+                    }
+                    product[i + N] = carry;
+                }
+                uint64_t carry = 0;
+                for_each_chunk<2 * N>([&](size_t i) {
+                    const uint64_t next_carry = product[i] >> 63;
+                    product[i] = (product[i] << 1) | carry;
+                    carry = next_carry;
+                });
+                carry = 0;
+                for_each_chunk<N>([&](size_t i) {
+                    const __uint128_t chunk = static_cast<__uint128_t>(number.mantissa[i]) * number.mantissa[i];
+                    __uint128_t sum = static_cast<__uint128_t>(product[2 * i]) + static_cast<uint64_t>(chunk) + carry;
+                    product[2 * i] = static_cast<uint64_t>(sum);
+                    sum = static_cast<__uint128_t>(product[2 * i + 1]) + static_cast<uint64_t>(chunk >> 64)
+                          + static_cast<uint64_t>(sum >> 64);
+                    product[2 * i + 1] = static_cast<uint64_t>(sum);
+                    carry = static_cast<uint64_t>(sum >> 64);
+                });
+            }
+            return from_chunks(product.data(), product.size(), number.exponent * 2, 0);
+        }
+
+        static constexpr BigFixed multiply(const BigFixed& lhs, uint64_t number) {
+            std::array<uint64_t, N + 1> product = {};
+            uint64_t carry = 0;
+            for_each_chunk<N>([&](size_t i) {
+                const __uint128_t chunk = static_cast<__uint128_t>(lhs.mantissa[i]) * number + carry;
+                product[i] = static_cast<uint64_t>(chunk);
+                carry = static_cast<uint64_t>(chunk >> 64);
+            });
+            product[N] = carry;
+            return from_chunks(product.data(), product.size(), lhs.exponent, lhs.sign);
+        }
+
+        static constexpr std::array<uint64_t, 2 * N> divide_chunks(const std::array<uint64_t, 2 * N>& dividend,
+                                                                   const std::array<uint64_t, N>& divisor) {
+            // Knuth's algorithm D, divisor is not zero
+            std::array<uint64_t, 2 * N> quotient = {};
+            size_t size = N;
+            while (divisor[size - 1] == 0)
+                --size;
+            if (size == 1) {
+                uint64_t remainder = 0;
+                for (size_t i = 2 * N; i-- > 0;) {
+                    const __uint128_t chunk = (static_cast<__uint128_t>(remainder) << 64) | dividend[i];
+                    quotient[i] = static_cast<uint64_t>(chunk / divisor[0]);
+                    remainder = static_cast<uint64_t>(chunk % divisor[0]);
+                }
+                return quotient;
+            }
+            const int shift = std::countl_zero(divisor[size - 1]);
+            std::array<uint64_t, N> v = {};
+            std::array<uint64_t, 2 * N + 1> u = {};
+            for (size_t i = 0; i < size; ++i)
+                v[i] = (divisor[i] << shift) | (shift != 0 && i > 0 ? divisor[i - 1] >> (64 - shift) : 0);
+            u[2 * N] = shift != 0 ? dividend[2 * N - 1] >> (64 - shift) : 0;
+            for (size_t i = 0; i < 2 * N; ++i)
+                u[i] = (dividend[i] << shift) | (shift != 0 && i > 0 ? dividend[i - 1] >> (64 - shift) : 0);
+
+            for (size_t j = 2 * N - size + 1; j-- > 0;) {
+                const __uint128_t top = (static_cast<__uint128_t>(u[j + size]) << 64) | u[j + size - 1];
+                __uint128_t estimate = top / v[size - 1];
+                __uint128_t rest = top % v[size - 1];
+                while ((estimate >> 64) != 0
+                       || estimate * v[size - 2] > ((rest << 64) | u[j + size - 2])) {
+                    --estimate;
+                    rest += v[size - 1];
+                    if ((rest >> 64) != 0)
+                        break;
+                }
+                uint64_t carry = 0;
+                uint64_t borrow = 0;
+                for (size_t i = 0; i < size; ++i) {
+                    const __uint128_t product = estimate * v[i] + carry;
+                    carry = static_cast<uint64_t>(product >> 64);
+                    const uint64_t low = static_cast<uint64_t>(product);
+                    const uint64_t difference = u[i + j] - low - borrow;
+                    borrow = u[i + j] < low || u[i + j] - low < borrow;
+                    u[i + j] = difference;
+                }
+                const bool negative = u[j + size] < carry || u[j + size] - carry < borrow;
+                u[j + size] -= carry + borrow;
+                if (negative) {
+                    // Estimate was one too large, add the divisor back
+                    --estimate;
+                    carry = 0;
+                    for (size_t i = 0; i < size; ++i) {
+                        const __uint128_t sum = static_cast<__uint128_t>(u[i + j]) + v[i] + carry;
+                        u[i + j] = static_cast<uint64_t>(sum);
+                        carry = static_cast<uint64_t>(sum >> 64);
+                    }
+                    u[j + size] += carry;
+                }
+                quotient[j] = static_cast<uint64_t>(estimate);
+            }
+            return quotient;
+        }
+
+        static constexpr BigFixed divide(const BigFixed& lhs, const BigFixed& rhs) {
+            if (rhs.is_zero())
+                throw std::runtime_error("Division by zero");
+            if (lhs.is_zero())
+                return lhs;
+            // Dividend is shifted up by N chunks to keep N chunks of quotient, as in BigNumber
+            std::array<uint64_t, 2 * N> dividend = {};
+            std::copy(lhs.mantissa.begin(), lhs.mantissa.end(), dividend.begin() + N);
+            const std::array<uint64_t, 2 * N> quotient = divide_chunks(dividend, rhs.mantissa);
+            return from_chunks(quotient.data(), quotient.size(),
+                               lhs.exponent - rhs.exponent - static_cast<int64_t>(N), lhs.sign != rhs.sign);
+        }
+
+        static constexpr BigFixed divide(const BigFixed& lhs, uint64_t number) {
+            if (number == 0)
+                throw std::runtime_error("Division by zero");
+            std::array<uint64_t, 2 * N> quotient = {};
+            uint64_t remainder = 0;
+            for (size_t i = 2 * N; i-- > N;) {
+                const __uint128_t chunk = (static_cast<__uint128_t>(remainder) << 64) | lhs.mantissa[i - N];
+                quotient[i] = static_cast<uint64_t>(chunk / number);
+                remainder = static_cast<uint64_t>(chunk % number);
+            }
+            for (size_t i = N; i-- > 0;) {
+                const __uint128_t chunk = static_cast<__uint128_t>(remainder) << 64;
+                quotient[i] = static_cast<uint64_t>(chunk / number);
+                remainder = static_cast<uint64_t>(chunk % number);
+            }
+            return from_chunks(quotient.data(), quotient.size(), lhs.exponent - static_cast<int64_t>(N), lhs.sign);
+        }
+
+     public:
+
+        // Constructors
+        constexpr BigFixed() = default;
+
+        template <std::integral T>
+        constexpr explicit BigFixed(T number) {
+            if (number == 0)
+                return;
+            if constexpr (std::is_signed_v<T>) {
+                sign = number < 0;
+                mantissa[0] = number < 0 ? -static_cast<uint64_t>(number) : static_cast<uint64_t>(number);
+            } else {
+                mantissa[0] = number;
+            }
+        }
+
+        explicit BigFixed(const char *s) : BigFixed(BigNumber(s, N * 64)) {}
+
+        explicit BigFixed(double number) : BigFixed(BigNumber(number, N * 64)) {}
+
+        explicit BigFixed(const BigNumber& number) {
+            *this = from_chunks(number.mantissa.data(), number.mantissa.size(), number.exponent, number.sign);
+        }
+
+        template <size_t M>
+        constexpr explicit BigFixed(const BigFixed<M>& number) {
+            *this = from_chunks(number.mantissa.data(), M, number.exponent, number.sign);
+        }
+
+        // Getters
+        [[nodiscard]] constexpr bool is_positive() const { return sign == 0; }
+        [[nodiscard]] constexpr bool is_negative() const { return sign != 0; }
+
+        [[nodiscard]] constexpr bool is_zero() const {
+            bool zero = true;
+            for_each_chunk<N>([&](size_t i) { zero = zero && mantissa[i] == 0; });
+            return zero;
+        }
+
+        // Unary minus
+        friend constexpr BigFixed operator-(const BigFixed& number) {
+            BigFixed result = number;
+            result.sign = number.is_zero() ? 0 : 1 - number.sign;
+            return result;
+        }
+
+        // Math utils
+        friend constexpr BigFixed abs(const BigFixed& number) {
+            BigFixed result = number;
+            result.sign = 0;
+            return result;
+        }
+
+        friend constexpr BigFixed floor(const BigFixed& number) {
+            // Drops the fraction chunks, like BigNumber
+            if (number.exponent >= 0)
+                return number;
+            std::array<uint64_t, N> integer = {};
+            for (int64_t i = -number.exponent; i < static_cast<int64_t>(N); ++i)
+                integer[i + number.exponent] = number.mantissa[i];
+            return from_chunks(integer.data(), N, 0, number.sign);
+        }
+
+        friend constexpr BigFixed ceil(const BigFixed& number) {
+            // Drops the fraction chunks and moves one away from zero when any was set, like BigNumber
+            if (number.exponent >= 0)
+                return number;
+            bool rounded = false;
+            for (int64_t i = 0; i < std::min(-number.exponent, static_cast<int64_t>(N)); ++i)
+                rounded = rounded || number.mantissa[i] != 0;
+            BigFixed result = floor(number);
+            if (rounded)
+                result = add(result, BigFixed(1), number.sign != 0);
+            return result;
+        }
+
+        friend constexpr BigFixed sqr(const BigFixed& number) {
+            return square(number);
+        }
+
+        friend constexpr BigFixed pow(const BigFixed& number, uint64_t pow) {
+            BigFixed result(1);
+            BigFixed multiplier = number;
+            while (pow > 0) {
+                if (pow & 1)
+                    result *= multiplier;
+                multiplier = square(multiplier);
+                pow >>= 1;
+            }
+            return result;
+        }
+
+        friend constexpr BigFixed arctan(const BigFixed& number) {
+            BigFixed result;
+            BigFixed next_result = number;
+            BigFixed summand = number;
+            const BigFixed number_square = square(number);
+            uint64_t n = 2;
+            size_t identity_count = 0;
+            do {
+                result = next_result;
+                summand *= (number_square * (n + n - 3)) / (n + n - 1);
+                if (n % 2 == 1)
+                    next_result += summand;
+                else
+                    next_result -= summand;
+                ++n;
+                if (static_cast<int64_t>(N) < result.exponent - summand.exponent)
+                    ++identity_count;
+                else
+                    identity_count = 0;
+            } while (identity_count < 10);
+            return result;
+        }
+
+        friend constexpr BigFixed factorial(const BigFixed& number) {
+            if (number.exponent < 0)
+                return BigFixed();
+            BigFixed result(1);
+            BigFixed i(1);
+            while (i <= number) {
+                result *= i;
+                i += 1;
+            }
+            return result;
+        }
+
+        // Addition and subtraction
+        friend constexpr BigFixed operator+(const BigFixed& lhs, const BigFixed& rhs) { return add(lhs, rhs, false); }
+        friend constexpr BigFixed operator-(const BigFixed& lhs, const BigFixed& rhs) { return add(lhs, rhs, true); }
+        friend constexpr BigFixed& operator+=(BigFixed& self, const BigFixed& other) { return self = self + other; }
+        friend constexpr BigFixed& operator-=(BigFixed& self, const BigFixed& other) { return self = self - other; }
+        friend constexpr BigFixed& operator+=(BigFixed& self, uint64_t number) { return self += BigFixed(number); }
+
+        // Multiplication and division
+        friend constexpr BigFixed operator*(const BigFixed& lhs, const BigFixed& rhs) { return multiply(lhs, rhs); }
+        friend constexpr BigFixed operator*(const BigFixed& lhs, uint64_t number) { return multiply(lhs, number); }
+        friend constexpr BigFixed operator/(const BigFixed& lhs, const BigFixed& rhs) { return divide(lhs, rhs); }
+        friend constexpr BigFixed operator/(const BigFixed& lhs, uint64_t number) { return divide(lhs, number); }
+        friend constexpr BigFixed& operator*=(BigFixed& self, const BigFixed& other) { return self = self * other; }
+        friend constexpr BigFixed& operator*=(BigFixed& self, uint64_t number) { return self = self * number; }
+        friend constexpr BigFixed& operator/=(BigFixed& self, const BigFixed& other) { return self = self / other; }
+        friend constexpr BigFixed& operator/=(BigFixed& self, uint64_t number) { return self = self / number; }
+
+        // Comparison
+        friend constexpr std::strong_ordering operator<=>(const BigFixed& lhs, const BigFixed& rhs) {
+            const bool lhs_negative = lhs.sign != 0 && !lhs.is_zero();
+            const bool rhs_negative = rhs.sign != 0 && !rhs.is_zero();
+            if (lhs_negative != rhs_negative)
+                return rhs_negative <=> lhs_negative;
+            return lhs_negative ? compare_magnitudes(rhs, lhs) : compare_magnitudes(lhs, rhs);
+        }
+
+        friend constexpr bool operator==(const BigFixed& lhs, const BigFixed& rhs) {
+            return (lhs <=> rhs) == std::strong_ordering::equal;
+        }
+
+        // Stream representation
+        friend std::ostream& operator<<(std::ostream& outs, const BigFixed& number) {
+            outs << number.to_string();
+            return outs;
+        }
+
+        // Adapters
+        explicit operator BigNumber() const {
+            BigNumber result(static_cast<uint64_t>(0), N * 64);
+            result.sign = sign;
+            result.exponent = exponent;
+            std::copy(mantissa.begin(), mantissa.end(), result.mantissa.begin());
+            return result;
+        }
+
+        [[nodiscard]] std::string to_string() const {
+            return static_cast<BigNumber>(*this).to_string();
+        }
+    };
+}
@@ -1,7 +1,131 @@
 #include "big_number.h"
 
+#include <cmath>
+
 namespace BigNumber {
 
+    namespace {
+        // Bits beyond the precision to which elementary functions are evaluated in fixed point
+        const uint64_t ELEMENTARY_GUARD_BITS = 64;
+
+        struct SinCos {
+            VectorUtils::SignedVector sine;
+            VectorUtils::SignedVector cosine;
+        };
+
+        VectorUtils::ChunkVector exp_scaled(const VectorUtils::SignedVector& x, uint64_t bits, int64_t& exponent) {
+            // exp(x) = result * 2^(exponent - bits) for x with bits + 64 fraction bits, reduced to
+            // exp(x) = 2^k * exp(r) with r = x - k * log(2) in [0, log(2))
+            exponent = 0;
+            if (x.magnitude.empty())
+                return VectorUtils::power_of_two(bits);
+            const VectorUtils::ChunkVector log2 = VectorUtils::log2_vector(bits + 64);
+            VectorUtils::ChunkVector quotient;
+            VectorUtils::ChunkVector remainder = x.magnitude;
+            // Arguments below log(2) are reduced already
+            if (VectorUtils::compare_mantissas(x.magnitude, log2, 0) != std::strong_ordering::less) {
+                quotient = x.magnitude;
+                remainder = VectorUtils::trimmed(VectorUtils::divide_vectors(quotient, log2));
+                quotient = VectorUtils::trimmed(quotient);
+            }
+            if (quotient.size() > 1 || (!quotient.empty() && quotient[0] >= (uint64_t(1) << 62)))
+                throw std::runtime_error("Exponent is too large");
+            exponent = quotient.empty() ? 0 : static_cast<int64_t>(quotient[0]);
+            if (x.negative) {
+                exponent = -exponent;
+                if (!remainder.empty()) {
+                    --exponent;
+                    remainder = VectorUtils::subtract_signed({ log2, false }, { remainder, false }).magnitude;
+                }
+            }
+            return VectorUtils::exp_vector(VectorUtils::shifted_bits(remainder, -64), bits);
+        }
+
+        VectorUtils::SignedVector log_fixed(const VectorUtils::ChunkVector& mantissa, int64_t shift, uint64_t bits) {
+            // log(x) with bits fraction bits for x = mantissa * 2^shift, mantissa trimmed and not zero.
+            // With s = x * 2^m >= 2^(working / 2), log(s) = pi / (2 * AGM(1, 4 / s)) within 2^-working and
+            // log(x) = log(s) - m * log(2). 4 / s is that much smaller than 1, so the means carry half as many
+            // bits again to keep its relative precision
+            const int64_t top = static_cast<int64_t>(mantissa.size() * 64 - std::countl_zero(mantissa.back())) + shift;
+            const uint64_t working = bits + std::bit_width(bits + static_cast<uint64_t>(std::abs(top))) + 16;
+            const int64_t m = static_cast<int64_t>(working / 2) + 2 - top;
+            const uint64_t agm_bits = working + working / 2 + 16;
+            // 2^agm_bits * 4 / s = 2^(agm_bits + 2 - m - shift) / mantissa
+            VectorUtils::ChunkVector inverse = VectorUtils::power_of_two(agm_bits + 2 - m - shift);
+            VectorUtils::divide_vectors(inverse, mantissa);
+            const VectorUtils::ChunkVector mean = VectorUtils::agm_vector(VectorUtils::power_of_two(agm_bits),
+                                                                          VectorUtils::trimmed(inverse));
+            VectorUtils::ChunkVector log_s = VectorUtils::shifted_bits(VectorUtils::pi_vector(working), agm_bits - 1);
+            VectorUtils::divide_vectors(log_s, mean);
+            const VectorUtils::SignedVector m_log2 = {
+                VectorUtils::trimmed(VectorUtils::multiply_vectors(VectorUtils::log2_vector(working),
+                                                                   { static_cast<uint64_t>(std::abs(m)) })),
+                m < 0
+            };
+            const VectorUtils::SignedVector result = VectorUtils::subtract_signed(
+                    { VectorUtils::trimmed(log_s), false }, m_log2);
+            const VectorUtils::ChunkVector magnitude = VectorUtils::shifted_bits(
+                    result.magnitude, static_cast<int64_t>(bits) - static_cast<int64_t>(working));
+            return { magnitude, result.negative && !magnitude.empty() };
+        }
+
+        SinCos sin_cos_fixed(const VectorUtils::SignedVector& x, uint64_t x_bits, uint64_t bits) {
+            // sin(x) and cos(x) with bits fraction bits for x with x_bits fraction bits, reduced to
+            // x = k * pi / 2 + r with r in [0, pi / 4] or pi / 2 - r in [0, pi / 4]
+            VectorUtils::ChunkVector sine;
+            VectorUtils::ChunkVector cosine = VectorUtils::power_of_two(bits);
+            if (x.magnitude.empty())
+                return { { sine, false }, { cosine, false } };
+            const VectorUtils::ChunkVector half_pi = VectorUtils::shifted_bits(VectorUtils::pi_vector(x_bits), -1);
+            VectorUtils::ChunkVector quotient;
+            VectorUtils::ChunkVector remainder = x.magnitude;
+            if (VectorUtils::compare_mantissas(x.magnitude, half_pi, 0) != std::strong_ordering::less) {
+                quotient = x.magnitude;
+                remainder = VectorUtils::trimmed(VectorUtils::divide_vectors(quotient, half_pi));
+                quotient = VectorUtils::trimmed(quotient);
+            }
+            const uint64_t quadrant = quotient.empty() ? 0 : quotient[0] % 4;
+            const bool complement = VectorUtils::subtract_signed(
+                    { half_pi, false }, { VectorUtils::shifted_bits(remainder, 1), false }).negative;
+            if (complement)
+                remainder = VectorUtils::subtract_signed({ half_pi, false }, { remainder, false }).magnitude;
+            VectorUtils::sin_cos_vector(
+                    VectorUtils::shifted_bits(remainder, static_cast<int64_t>(bits) - static_cast<int64_t>(x_bits)),
+                    bits, sine, cosine);
+            if (complement)
+                std::swap(sine, cosine);
+            // sin(k * pi / 2 + r) and cos(k * pi / 2 + r) by quadrant
+            SinCos result;
+            switch (quadrant) {
+                case 0:
+                    result = { { sine, false }, { cosine, false } };
+                    break;
+                case 1:
+                    result = { { cosine, false }, { sine, true } };
+                    break;
+                case 2:
+                    result = { { sine, true }, { cosine, true } };
+                    break;
+                default:
+                    result = { { cosine, true }, { sine, false } };
+                    break;
+            }
+            result.sine.negative = (result.sine.negative != x.negative) && !result.sine.magnitude.empty();
+            result.cosine.negative = result.cosine.negative && !result.cosine.magnitude.empty();
+            return result;
+        }
+
+        double approximate(const VectorUtils::SignedVector& value, int64_t bits) {
+            // value / 2^bits as a double
+            if (value.magnitude.empty())
+                return 0;
+            const int64_t width = static_cast<int64_t>(value.magnitude.size() * 64
+                                                       - std::countl_zero(value.magnitude.back()));
+            const double top = static_cast<double>(VectorUtils::shifted_bits(value.magnitude, 64 - width)[0]);
+            return std::ldexp(value.negative ? -top : top, static_cast<int>(width - 64 - bits));
+        }
+    }
+
     BigNumber::BigNumber(const char *s, uint64_t precision) {
         size_t mantissa_size = precision / 64 + (precision % 64 > 0);
         std::istringstream iss(s);
@@ -27,10 +151,10 @@ namespace BigNumber {
             integer_slice = number.substr(0, number.find('.'));
             fraction_slice = number.substr(number.find('.') + 1);
         }
-        std::vector<uint64_t> integer = VectorUtils::to_integer_vector(integer_slice);
-        std::vector<uint64_t> fraction = VectorUtils::to_fraction_vector(fraction_slice,
-                                                                         mantissa_size - integer.size());
-        exponent = -static_cast<int64_t>(mantissa_size - integer.size());
+        VectorUtils::ChunkVector integer = VectorUtils::to_integer_vector(integer_slice);
+        const uint64_t fraction_size = mantissa_size > integer.size() ? mantissa_size - integer.size() : 0;
+        VectorUtils::ChunkVector fraction = VectorUtils::to_fraction_vector(fraction_slice, fraction_size);
+        exponent = -static_cast<int64_t>(fraction_size);
         VectorUtils::extend(mantissa, fraction);
         VectorUtils::extend(mantissa, integer);
         const uint64_t shift = VectorUtils::normalise_mantissa(mantissa, mantissa_size);
@@ -172,40 +296,57 @@ namespace BigNumber {
         return result;
     }
 
-    /*BigNumber sqrt(const BigNumber& number) {
-        const int64_t initial_exponent = number.exponent;
-        BigNumber one(1, number.mantissa.size() * 3 * 64);
-        BigNumber half(0.5, number.mantissa.size() * 3 * 64);
-        BigNumber start(1, number.mantissa.size() * 3 * 64);
-        BigNumber end = number;
-        end.exponent = static_cast<int64_t>(number.mantissa.size() * 2);
-        end.mantissa.resize(number.mantissa.size() * 3, 0);
-        BigNumber target = end;
-        BigNumber mid(0, number.mantissa.size() * 3 * 64);
-        BigNumber square(0, number.mantissa.size() * 3 * 64);
-        BigNumber ans(0, number.mantissa.size() * 3 * 64);
-        while (start <= end) {
-            mid = floor((start + end) * half);
-            square = mid * mid;
-            if (square == target) {
-                ans = mid;
-                break;
-            }
-            if (square < target) {
-                start = mid + one;
-                ans = mid;
-            } else {
-                end = mid - one;
-            }
-        }
-        if (initial_exponent % 2 != 0)
-            VectorUtils::half_shift_right(ans.mantissa);
-        const uint64_t shift = VectorUtils::normalise_mantissa(ans.mantissa, number.mantissa.size());
-        ans.exponent = initial_exponent / 2
-                       - static_cast<int64_t>(number.mantissa.size())
-                       + static_cast<int64_t>(shift);
-        return ans;
-    }*/
+    BigNumber sqrt(const BigNumber& number) {
+        // floor(sqrt(mantissa * B^shift)) * B^((exponent - shift) / 2), the root has two chunks beyond the precision
+        if (number.sign != 0 && !number.is_zero())
+            throw std::runtime_error("Square root of a negative number");
+        const uint64_t size = number.mantissa.size();
+        BigNumber result(0, size * 64);
+        if (number.is_zero())
+            return result;
+        // The radicand gets 2 * size + 4 significant chunks whatever the number of zero chunks above the mantissa
+        const VectorUtils::ChunkVector significant = VectorUtils::trimmed(number.mantissa);
+        int64_t shift = 2 * static_cast<int64_t>(size) + 4 - static_cast<int64_t>(significant.size());
+        if ((number.exponent - shift) % 2 != 0)
+            ++shift;
+        VectorUtils::ChunkVector scaled(shift, 0);
+        VectorUtils::extend(scaled, significant);
+        result.mantissa = VectorUtils::sqrt_vector(scaled);
+        const uint64_t normalised = VectorUtils::normalise_mantissa(result.mantissa, size);
+        result.exponent = (number.exponent - shift) / 2 + static_cast<int64_t>(normalised);
+        return result;
+    }
+
+    BigNumber rsqrt(const BigNumber& number) {
+        // floor(B^chunks / sqrt(mantissa * B^parity)) * B^(-chunks - (exponent - parity) / 2),
+        // the root has two chunks beyond the precision
+        if (number.is_zero())
+            throw std::runtime_error("Division by zero");
+        if (number.sign != 0)
+            throw std::runtime_error("Square root of a negative number");
+        const uint64_t size = number.mantissa.size();
+        const int64_t parity = number.exponent % 2 != 0 ? 1 : 0;
+        VectorUtils::ChunkVector scaled(parity, 0);
+        VectorUtils::extend(scaled, number.mantissa);
+        const uint64_t chunks = size + 2 + (scaled.size() + 1) / 2;
+        BigNumber result(0, size * 64);
+        result.mantissa = VectorUtils::rsqrt_vector(scaled, chunks * 64);
+        const uint64_t normalised = VectorUtils::normalise_mantissa(result.mantissa, size);
+        result.exponent = static_cast<int64_t>(normalised) - static_cast<int64_t>(chunks)
+                          - (number.exponent - parity) / 2;
+        return result;
+    }
+
+    BigNumber sqr(const BigNumber& number) {
+        BigNumber result(0, 64);
+        result.assign_square(number);
+        return result;
+    }
+
+    BigNumber& square(BigNumber& number) {
+        number.assign_square(number);
+        return number;
+    }
 
     BigNumber pow(const BigNumber& number, uint64_t pow) {
         BigNumber result(1, number.mantissa.size() * 64);
@@ -215,21 +356,172 @@ namespace BigNumber {
         while (pow > 0) {
             if (pow & 1)
                 result *= multiplier;
-            multiplier *= multiplier;
+            square(multiplier);
             pow >>= 1;
         }
         return result;
     }
 
+    BigNumber pow(const BigNumber& number, const BigNumber& power) {
+        // Integer powers by squaring, others as exp(power * log(number)) of a positive number
+        const uint64_t precision = number.mantissa.size() * 64;
+        if (power.is_zero())
+            return BigNumber(1, precision);
+        const int64_t power_top = power.binary_exponent();
+        const bool integer = floor(power) == power;
+        if (integer && power_top <= 64) {
+            const VectorUtils::SignedVector exponent = power.to_fixed(0);
+            const BigNumber result = pow(number, exponent.magnitude[0]);
+            return power.sign != 0 ? BigNumber(1, precision) / result : result;
+        }
+        if (number.is_zero()) {
+            if (power.sign != 0)
+                throw std::runtime_error("Division by zero");
+            return BigNumber(0, precision);
+        }
+        if (number.sign != 0 && !integer)
+            throw std::runtime_error("Power of a negative number");
+        // The product carries as many more bits as the power has integer bits, the power's own truncation
+        // as many as the logarithm has
+        const uint64_t bits = precision + ELEMENTARY_GUARD_BITS;
+        const uint64_t top = static_cast<uint64_t>(std::abs(number.binary_exponent())) + 1;
+        const uint64_t log_bits = bits + 64 + std::max<int64_t>(power_top, 0) + std::bit_width(top) + 8;
+        const VectorUtils::SignedVector logarithm = log_fixed(VectorUtils::trimmed(number.mantissa),
+                                                              64 * number.exponent, log_bits);
+        const VectorUtils::SignedVector product = VectorUtils::multiply_signed(power.to_fixed(log_bits), logarithm);
+        const VectorUtils::ChunkVector magnitude = VectorUtils::shifted_bits(
+                product.magnitude, static_cast<int64_t>(bits + 64) - static_cast<int64_t>(2 * log_bits));
+        int64_t exponent;
+        const VectorUtils::ChunkVector result_magnitude = exp_scaled({ magnitude, product.negative }, bits, exponent);
+        // Integers of 2^64 and more are even unless their lowest chunk is in the mantissa
+        const bool odd = integer && power.exponent <= 0 && (power.mantissa[-power.exponent] & 1) != 0;
+        BigNumber result(0, precision);
+        result.assign_scaled(result_magnitude, exponent - static_cast<int64_t>(bits), number.sign != 0 && odd);
+        return result;
+    }
+
+    BigNumber exp(const BigNumber& number) {
+        const uint64_t precision = number.mantissa.size() * 64;
+        if (!number.is_zero() && number.binary_exponent() > 62)
+            throw std::runtime_error("Exponent is too large");
+        const uint64_t bits = precision + ELEMENTARY_GUARD_BITS;
+        int64_t exponent;
+        const VectorUtils::ChunkVector magnitude = exp_scaled(number.to_fixed(static_cast<int64_t>(bits + 64)), bits,
+                                                              exponent);
+        BigNumber result(0, precision);
+        result.assign_scaled(magnitude, exponent - static_cast<int64_t>(bits), false);
+        return result;
+    }
+
+    BigNumber log(const BigNumber& number) {
+        if (number.is_zero() || number.sign != 0)
+            throw std::runtime_error("Logarithm of a non-positive number");
+        const uint64_t precision = number.mantissa.size() * 64;
+        // Close to 1 the logarithm is about number - 1, which has that many more leading zero bits
+        BigNumber difference = number;
+        difference -= BigNumber(1, precision);
+        if (difference.is_zero())
+            return BigNumber(0, precision);
+        const uint64_t bits = precision + ELEMENTARY_GUARD_BITS
+                              + std::max<int64_t>(2 - difference.binary_exponent(), 0);
+        const VectorUtils::SignedVector value = log_fixed(VectorUtils::trimmed(number.mantissa), 64 * number.exponent,
+                                                          bits);
+        BigNumber result(0, precision);
+        result.assign_scaled(value.magnitude, -static_cast<int64_t>(bits), value.negative);
+        return result;
+    }
+
+    BigNumber sin(const BigNumber& number) {
+        // Small arguments keep their relative precision, large ones need as many more bits of pi
+        const uint64_t precision = number.mantissa.size() * 64;
+        BigNumber result(0, precision);
+        if (number.is_zero())
+            return result;
+        const int64_t top = number.binary_exponent();
+        const uint64_t bits = precision + ELEMENTARY_GUARD_BITS + std::max<int64_t>(-top, 0);
+        const uint64_t x_bits = bits + std::max<int64_t>(top, 0) + 8;
+        const SinCos values = sin_cos_fixed(number.to_fixed(static_cast<int64_t>(x_bits)), x_bits, bits);
+        result.assign_scaled(values.sine.magnitude, -static_cast<int64_t>(bits), values.sine.negative);
+        return result;
+    }
+
+    BigNumber cos(const BigNumber& number) {
+        const uint64_t precision = number.mantissa.size() * 64;
+        BigNumber result(0, precision);
+        const uint64_t bits = precision + ELEMENTARY_GUARD_BITS;
+        const uint64_t x_bits = bits + (number.is_zero() ? 0 : std::max<int64_t>(number.binary_exponent(), 0)) + 8;
+        const SinCos values = sin_cos_fixed(number.to_fixed(static_cast<int64_t>(x_bits)), x_bits, bits);
+        result.assign_scaled(values.cosine.magnitude, -static_cast<int64_t>(bits), values.cosine.negative);
+        return result;
+    }
+
+    BigNumber atan2(const BigNumber& y, const BigNumber& x) {
+        // The angle of (x, y) in (-pi, pi] by Newton's iteration theta + (y cos(theta) - x sin(theta)) /
+        // (x cos(theta) + y sin(theta)) from a double, each step at about twice the bits of the previous one
+        // relative to the angle
+        const uint64_t precision = std::max(y.mantissa.size(), x.mantissa.size()) * 64;
+        BigNumber result(0, precision);
+        if (y.is_zero() && x.is_zero())
+            return result;
+        const int64_t y_top = y.is_zero() ? INT64_MIN : y.binary_exponent();
+        const int64_t x_top = x.is_zero() ? INT64_MIN : x.binary_exponent();
+        const int64_t top = std::max(y_top, x_top);
+        // Angles close to 0 keep their relative precision
+        const uint64_t extra = y.is_zero() || x.is_zero() ? 0 : std::max<int64_t>(x_top - y_top, 0);
+        const uint64_t bits = precision + ELEMENTARY_GUARD_BITS + extra;
+        // x and y scaled below 1
+        const VectorUtils::SignedVector scaled_x = x.to_fixed(static_cast<int64_t>(bits) - top);
+        const VectorUtils::SignedVector scaled_y = y.to_fixed(static_cast<int64_t>(bits) - top);
+        const double initial = std::atan2(approximate(scaled_y, static_cast<int64_t>(bits)),
+                                          approximate(scaled_x, static_cast<int64_t>(bits)));
+        // The 53 bits of the double wherever they are, tiny angles included
+        int initial_exponent = 0;
+        const double initial_mantissa = std::frexp(std::abs(initial), &initial_exponent);
+        VectorUtils::SignedVector theta = {
+            VectorUtils::trimmed(VectorUtils::shifted_bits(
+                    { static_cast<uint64_t>(std::ldexp(initial_mantissa, 53)) },
+                    static_cast<int64_t>(bits) + initial_exponent - 53)),
+            initial < 0
+        };
+        std::vector<uint64_t> steps;
+        for (uint64_t step_bits = bits - extra; step_bits > 96; step_bits = step_bits / 2 + 32)
+            steps.push_back(step_bits + extra);
+        for (auto step = steps.rbegin(); step != steps.rend(); ++step) {
+            const int64_t shift = static_cast<int64_t>(*step) - static_cast<int64_t>(bits);
+            const SinCos values = sin_cos_fixed(
+                    { VectorUtils::shifted_bits(theta.magnitude, shift + 8), theta.negative }, *step + 8, *step);
+            const VectorUtils::SignedVector step_x = { VectorUtils::shifted_bits(scaled_x.magnitude, shift),
+                                                       scaled_x.negative };
+            const VectorUtils::SignedVector step_y = { VectorUtils::shifted_bits(scaled_y.magnitude, shift),
+                                                       scaled_y.negative };
+            const VectorUtils::SignedVector numerator = VectorUtils::subtract_signed(
+                    VectorUtils::multiply_signed(step_y, values.cosine),
+                    VectorUtils::multiply_signed(step_x, values.sine));
+            const VectorUtils::SignedVector denominator = VectorUtils::add_signed(
+                    VectorUtils::multiply_signed(step_x, values.cosine),
+                    VectorUtils::multiply_signed(step_y, values.sine));
+            if (numerator.magnitude.empty())
+                break;
+            VectorUtils::ChunkVector correction = VectorUtils::shifted_bits(numerator.magnitude,
+                                                                            static_cast<int64_t>(*step));
+            VectorUtils::divide_vectors(correction, denominator.magnitude);
+            correction = VectorUtils::shifted_bits(VectorUtils::trimmed(correction), -shift);
+            theta = VectorUtils::add_signed(theta, { correction, numerator.negative != denominator.negative });
+        }
+        result.assign_scaled(theta.magnitude, -static_cast<int64_t>(bits), theta.negative);
+        return result;
+    }
+
     BigNumber arctan(const BigNumber& number) {
         BigNumber result(0.0, number.mantissa.size() * 64);
         BigNumber next_result = number;
         BigNumber summand = number;
+        const BigNumber number_square = sqr(number);
         uint64_t n = 2;
         size_t identity_count = 0;
         do {
             result = next_result;
-            summand *= (number * number * (n + n - 3)) / (n + n - 1);
+            summand *= (number_square * (n + n - 3)) / (n + n - 1);
             if (n % 2 == 1)
                 next_result += summand;
             else
@@ -244,89 +536,73 @@ namespace BigNumber {
         return result;
     }
 
+    BigNumber arctan_inverse(uint64_t k, uint64_t precision) {
+        // arctan(1 / k) = sum (-1)^n / ((2n + 1) * k^(2n + 1)) summed by binary splitting
+        if (k < 2)
+            throw std::runtime_error("arctan_inverse needs k > 1");
+        BigNumber result(0, precision);
+        // Terms fall by at least 2^(2 * (bit_width(k) - 1)), sum them to one chunk beyond the mantissa
+        const uint64_t terms = (result.mantissa.size() + 1) * 64 / (2 * (std::bit_width(k) - 1)) + 1;
+        const VectorUtils::SeriesSum sum = VectorUtils::sum_series([k](uint64_t n) {
+            const __uint128_t q = n == 0 ? k : static_cast<__uint128_t>(k) * k;
+            return VectorUtils::SeriesTerm{ 1, 2 * n + 1, 1, q, n != 0 };
+        }, 0, terms);
+        result.assign_quotient(sum.numerator, sum.denominator, sum.negative);
+        return result;
+    }
+
     BigNumber factorial(const BigNumber& number) {
         if (number.exponent < 0)
             return BigNumber(0, number.mantissa.size() * 64);
-        if (number.is_zero())
+        if (number.is_zero() || number.sign != 0)
             return BigNumber(1, number.mantissa.size() * 64);
+        if (number.exponent > 0 || std::any_of(number.mantissa.begin() + 1, number.mantissa.end(),
+                                               [](uint64_t chunk) { return chunk != 0; }))
+            throw std::runtime_error("Factorial argument is too large");
         BigNumber result(1, number.mantissa.size() * 64);
-        BigNumber i(1, number.mantissa.size() * 64);
-        while (i <= number) {
-            result *= i;
-            i += 1;
-        }
+        uint64_t shift;
+        result.mantissa = VectorUtils::multiply_range(2, number.mantissa[0] + 1, result.mantissa.size(), shift);
+        shift += VectorUtils::normalise_mantissa(result.mantissa, number.mantissa.size());
+        result.exponent = static_cast<int64_t>(shift);
         return result;
     }
 
 
     // Addition and subtraction
     void BigNumber::add_positive(const BigNumber& number) {
-        const uint64_t initial_size = mantissa.size();
-        BigNumber summand = number;
-        uint64_t calc_size;
-        if (exponent < summand.exponent) {
-            calc_size = std::max(mantissa.size() + summand.exponent - exponent,
-                                 summand.mantissa.size());
-            summand.mantissa.resize(calc_size, 0);
-            mantissa.resize(calc_size, 0);
-            VectorUtils::shift_right(summand.mantissa, summand.exponent - exponent);
-        } else if (exponent > summand.exponent) {
-            calc_size = std::max(summand.mantissa.size() + exponent - summand.exponent,
-                                 mantissa.size());
-            summand.mantissa.resize(calc_size, 0);
-            mantissa.resize(calc_size, 0);
-            VectorUtils::shift_right(mantissa, exponent - summand.exponent);
-            exponent = summand.exponent;
-        } else {
-            calc_size = std::max(summand.mantissa.size(), mantissa.size());
-            summand.mantissa.resize(calc_size, 0);
-            mantissa.resize(calc_size, 0);
-        }
-        const uint64_t carry = VectorUtils::add_vector(mantissa, summand.mantissa);
-        if (carry != 0)
-            mantissa.push_back(1);
-        const uint64_t shift = VectorUtils::normalise_mantissa(mantissa, initial_size);
-        exponent += static_cast<int64_t>(shift);
+        exponent += VectorUtils::add_mantissa(mantissa, number.mantissa, number.exponent - exponent, mantissa.size());
     }
 
     void BigNumber::subtract_positive(const BigNumber& number) {
-        const uint64_t initial_size = mantissa.size();
-        BigNumber subtrahend = number;
-        if (exponent < subtrahend.exponent) {
-            const uint64_t calc_size = std::max(mantissa.size() + subtrahend.exponent - exponent,
-                                                subtrahend.mantissa.size());
-            subtrahend.mantissa.resize(calc_size, 0);
-            mantissa.resize(calc_size, 0);
-            VectorUtils::shift_right(subtrahend.mantissa, subtrahend.exponent - exponent);
-        } else if (exponent > subtrahend.exponent) {
-            const uint64_t calc_size = std::max(subtrahend.mantissa.size() + exponent - subtrahend.exponent,
-                                                mantissa.size());
-            subtrahend.mantissa.resize(calc_size, 0);
-            mantissa.resize(calc_size, 0);
-            VectorUtils::shift_right(mantissa, exponent - subtrahend.exponent);
-            exponent = subtrahend.exponent;
+        exponent += VectorUtils::subtract_mantissa(mantissa, number.mantissa, number.exponent - exponent,
+                                                   mantissa.size());
+    }
+
+    void BigNumber::add_term(uint64_t term_sign, int64_t term_exponent, VectorUtils::ChunkVector term) {
+        // As operator+=, a larger term of the other sign keeps its precision
+        const int64_t offset = term_exponent - exponent;
+        if (sign == term_sign) {
+            exponent += VectorUtils::add_mantissa(mantissa, term, offset, mantissa.size());
+        } else if (VectorUtils::compare_mantissas(mantissa, term, offset) == std::strong_ordering::greater) {
+            exponent += VectorUtils::subtract_mantissa(mantissa, term, offset, mantissa.size());
         } else {
-            const uint64_t calc_size = std::max(subtrahend.mantissa.size(), mantissa.size());
-            subtrahend.mantissa.resize(calc_size, 0);
-            mantissa.resize(calc_size, 0);
+            std::swap(mantissa, term);
+            sign = term_sign;
+            exponent = term_exponent + VectorUtils::subtract_mantissa(mantissa, term, -offset, mantissa.size());
         }
-        VectorUtils::subtract_vector(mantissa, subtrahend.mantissa);
-        const uint64_t shift = VectorUtils::normalise_mantissa(mantissa, initial_size);
-        exponent += static_cast<int64_t>(shift);
     }
 
     BigNumber& operator+=(BigNumber& self, const BigNumber& other) {
         if (self.sign == other.sign) {
             self.add_positive(other);
             return self;
-        } else if (abs(self) > abs(other)) {
+        } else if (self.compare_magnitude(other) == std::strong_ordering::greater) {
             self.subtract_positive(other);
             return self;
         } else {
             BigNumber result = other;
             result.subtract_positive(self);
             self = result;
-            self.sign = 1 - self.sign;
             return self;
         }
     }
@@ -345,7 +621,7 @@ namespace BigNumber {
         if (self.sign != other.sign) {
             self.add_positive(other);
             return self;
-        } else if (abs(self) > abs(other)) {
+        } else if (self.compare_magnitude(other) == std::strong_ordering::greater) {
             self.subtract_positive(other);
             return self;
         } else {
@@ -357,51 +633,77 @@ namespace BigNumber {
         }
     }
 
-    BigNumber operator+(const BigNumber& lhs, const BigNumber& rhs) {
-        BigNumber result = lhs;
-        result += rhs;
-        return result;
+
+    // Multiplication and division
+    void BigNumber::assign_product(const BigNumber& lhs, const BigNumber& rhs) {
+        // Either operand may be this number
+        const uint64_t initial_size = lhs.mantissa.size();
+        const uint64_t product_sign = (lhs.sign != rhs.sign);
+        const int64_t product_exponent = lhs.exponent + rhs.exponent;
+        mantissa = VectorUtils::multiply_vectors(lhs.mantissa, rhs.mantissa);
+        const uint64_t shift = VectorUtils::normalise_mantissa(mantissa, initial_size);
+        sign = product_sign;
+        exponent = product_exponent + static_cast<int64_t>(shift);
     }
 
-    BigNumber operator-(const BigNumber& lhs, const BigNumber& rhs) {
-        BigNumber result = lhs;
-        result -= rhs;
-        return result;
+    void BigNumber::assign_product(const BigNumber& lhs, uint64_t number) {
+        const uint64_t initial_size = lhs.mantissa.size();
+        const uint64_t product_sign = lhs.sign;
+        const int64_t product_exponent = lhs.exponent;
+        mantissa = VectorUtils::multiply_vectors(lhs.mantissa, VectorUtils::ChunkVector(1, number));
+        const uint64_t shift = VectorUtils::normalise_mantissa(mantissa, initial_size);
+        sign = product_sign;
+        exponent = product_exponent + static_cast<int64_t>(shift);
     }
 
+    void BigNumber::assign_square(const BigNumber& number) {
+        const uint64_t initial_size = number.mantissa.size();
+        const int64_t square_exponent = number.exponent * 2;
+        mantissa = VectorUtils::square_vector(number.mantissa);
+        const uint64_t shift = VectorUtils::normalise_mantissa(mantissa, initial_size);
+        sign = 0;
+        exponent = square_exponent + static_cast<int64_t>(shift);
+    }
+
+    void BigNumber::add_product(const BigNumber& lhs, const BigNumber& rhs, bool negative) {
+        VectorUtils::ChunkVector product = VectorUtils::multiply_vectors(lhs.mantissa, rhs.mantissa);
+        const uint64_t shift = VectorUtils::normalise_mantissa(product, lhs.mantissa.size());
+        add_term((lhs.sign != rhs.sign) != negative, lhs.exponent + rhs.exponent + static_cast<int64_t>(shift),
+                 std::move(product));
+    }
+
+    void BigNumber::add_product(const BigNumber& lhs, uint64_t number, bool negative) {
+        VectorUtils::ChunkVector product = VectorUtils::multiply_vectors(lhs.mantissa,
+                                                                         VectorUtils::ChunkVector(1, number));
+        const uint64_t shift = VectorUtils::normalise_mantissa(product, lhs.mantissa.size());
+        add_term((lhs.sign != 0) != negative, lhs.exponent + static_cast<int64_t>(shift), std::move(product));
+    }
 
-    // Multiplication and division
     BigNumber& operator*=(BigNumber& self, const BigNumber& other) {
-        const uint64_t initial_size = self.mantissa.size();
-        self.mantissa = VectorUtils::multiply_vectors(self.mantissa, other.mantissa);
-        const uint64_t shift = VectorUtils::normalise_mantissa(self.mantissa, initial_size);
-        self.sign = (self.sign != other.sign);
-        self.exponent += static_cast<int64_t>(other.exponent + shift);
+        self.assign_product(self, other);
         return self;
     }
 
     BigNumber& operator*=(BigNumber& self, uint64_t number) {
-        const uint64_t initial_size = self.mantissa.size();
-        self.mantissa = VectorUtils::multiply_vectors(self.mantissa,
-                                                      std::vector<uint64_t>(1, number));
-        const uint64_t shift = VectorUtils::normalise_mantissa(self.mantissa, initial_size);
-        self.exponent += static_cast<int64_t>(shift);
+        self.assign_product(self, number);
         return self;
     }
 
     BigNumber& operator/=(BigNumber& self, const BigNumber& other) {
         if (other.is_zero())
             throw std::runtime_error("Division by zero");
+        if (self.is_zero())
+            return self;
         const uint64_t initial_size = self.mantissa.size();
-        std::vector<uint64_t> dividend = self.mantissa;
+        VectorUtils::ChunkVector dividend = self.mantissa;
         dividend.resize(initial_size << 1, 0);
         VectorUtils::shift_right(dividend, initial_size);
         while (dividend.back() == 0)
             dividend.pop_back();
-        std::vector<uint64_t> divisor = other.mantissa;
+        VectorUtils::ChunkVector divisor = other.mantissa;
         while (divisor.back() == 0)
             divisor.pop_back();
-        VectorUtils::modulo_vector(dividend, divisor);
+        VectorUtils::divide_vectors(dividend, divisor);
         self.mantissa = dividend;
         const uint64_t shift = VectorUtils::normalise_mantissa(self.mantissa, initial_size);
         self.sign = (self.sign != other.sign);
@@ -409,21 +711,19 @@ namespace BigNumber {
         return self;
     }
 
-    BigNumber operator*(const BigNumber& lhs, const BigNumber& rhs) {
-        BigNumber result = lhs;
-        result *= rhs;
-        return result;
-    }
-
-    BigNumber operator*(const BigNumber& self, uint64_t number) {
+    BigNumber& operator/=(BigNumber& self, uint64_t number) {
+        if (number == 0)
+            throw std::runtime_error("Division by zero");
+        if (self.is_zero())
+            return self;
         const uint64_t initial_size = self.mantissa.size();
-        BigNumber result(0, initial_size);
-        result.mantissa = VectorUtils::multiply_vectors(self.mantissa,
-                                                        std::vector<uint64_t>(1, number));
-        const uint64_t shift = VectorUtils::normalise_mantissa(result.mantissa, initial_size);
-        result.sign = self.sign;
-        result.exponent = self.exponent + static_cast<int64_t>(shift);
-        return result;
+        VectorUtils::ChunkVector dividend(initial_size, 0);
+        VectorUtils::extend(dividend, self.mantissa);
+        VectorUtils::modulo_vector(dividend, number);
+        self.mantissa = dividend;
+        const uint64_t shift = VectorUtils::normalise_mantissa(self.mantissa, initial_size);
+        self.exponent += static_cast<int64_t>(shift - initial_size);
+        return self;
     }
 
     BigNumber operator/(const BigNumber& lhs, const BigNumber& rhs) {
@@ -432,12 +732,18 @@ namespace BigNumber {
         return result;
     }
 
-    BigNumber operator/(const BigNumber& self, uint64_t number) {
-        return self / BigNumber(number, self.mantissa.size() * 64);
+    BigNumber operator/(const BigNumber& lhs, uint64_t number) {
+        BigNumber result = lhs;
+        result /= number;
+        return result;
     }
 
 
     // Comparison
+    std::strong_ordering BigNumber::compare_magnitude(const BigNumber& number) const {
+        return VectorUtils::compare_mantissas(mantissa, number.mantissa, number.exponent - exponent);
+    }
+
     std::strong_ordering operator<=>(const BigNumber& lhs, const BigNumber& rhs) {
         if (lhs.is_zero() && rhs.is_zero())
             return std::strong_ordering::equal;
@@ -445,21 +751,10 @@ namespace BigNumber {
             return std::strong_ordering::less;
         if (lhs.sign == 0 && rhs.sign != 0)
             return std::strong_ordering::greater;
-        BigNumber lhs_copy = lhs;
-        BigNumber rhs_copy = rhs;
-        lhs_copy.normalise();
-        rhs_copy.normalise();
-        const uint64_t comp_diff = std::abs(lhs.exponent - rhs.exponent);
-        const uint64_t comp_size = std::max(lhs.mantissa.size(), rhs.mantissa.size()) + comp_diff;
-        lhs_copy.mantissa.resize(comp_size, 0);
-        rhs_copy.mantissa.resize(comp_size, 0);
-        if (lhs.exponent < rhs.exponent) {
-            VectorUtils::shift_right(rhs_copy.mantissa, rhs.exponent - lhs.exponent);
-        } else if (lhs.exponent > rhs.exponent) {
-            VectorUtils::shift_right(lhs_copy.mantissa, lhs.exponent - rhs.exponent);
-        }
-        const std::strong_ordering result = VectorUtils::compare_vectors(lhs_copy.mantissa, rhs_copy.mantissa);
-        return result;
+        // Magnitudes compare the other way round for negative numbers
+        if (lhs.sign != 0)
+            return rhs.compare_magnitude(lhs);
+        return lhs.compare_magnitude(rhs);
     }
 
     bool operator==(const BigNumber& lhs, const BigNumber& rhs) {
@@ -469,54 +764,105 @@ namespace BigNumber {
 
     // Stream representation
     std::ostream& operator<<(std::ostream& outs, const BigNumber& number) {
-        outs << number.to_string();
+        number.write(outs);
         return outs;
     }
 
+    void BigNumber::write(std::ostream& outs, uint64_t limit) const {
+        write([&outs](std::string_view characters) {
+            outs.write(characters.data(), static_cast<std::streamsize>(characters.size()));
+        }, limit);
+    }
 
-    // Adapters
-    std::string BigNumber::to_string() const {
-        if (is_zero())
-            return "0";
-        std::string result;
-        std::vector<uint64_t> integer;
+    void BigNumber::write(const VectorUtils::DigitSink& sink, uint64_t limit) const {
+        // The characters of to_string() up to the limit'th digit
+        if (limit == 0)
+            return;
+        VectorUtils::DigitWriter writer(sink, limit);
+        if (is_zero()) {
+            writer.write_digits("0");
+            writer.flush();
+            return;
+        }
+        VectorUtils::ChunkVector integer;
         if (exponent <= 0) {
             if (-exponent > mantissa.size() - 1)
                 integer = { 0 };
             else
-                integer = std::vector(mantissa.begin() - exponent, mantissa.end());
+                integer = VectorUtils::ChunkVector(mantissa.begin() - exponent, mantissa.end());
         } else {
-            integer = mantissa;
-            VectorUtils::extend(integer, std::vector<uint64_t>(exponent, 0));
-            VectorUtils::shift_right(integer, exponent);
-            while (integer.back() == 0)
-                integer.pop_back();
+            integer = VectorUtils::ChunkVector(exponent, 0);
+            VectorUtils::extend(integer, mantissa);
         }
-        std::vector<uint64_t> ten = { 10 };
-        while (!VectorUtils::is_null(integer))
-            result.append(std::to_string(VectorUtils::modulo_vector(integer, ten)[0]));
-        if (result.empty())
-            result.append("0");
         if (sign != 0)
-            result.append("-");
-        std::reverse(result.begin(), result.end());
-        if (exponent >= 0)
-            return result;
-        std::vector<uint64_t> fraction(mantissa.begin(), mantissa.begin() - exponent);
-        if (fraction.empty() || VectorUtils::is_null(fraction))
-            return result;
-        result.append(".");
-        fraction.push_back(0);
-        while (!VectorUtils::is_null(fraction)) {
-            fraction = VectorUtils::multiply_vectors(fraction, ten);
-            fraction.pop_back();
-            result.append(std::to_string(fraction.back()));
-            fraction.back() = 0;
+            writer.write_symbol('-');
+        VectorUtils::write_integer_digits(writer, std::move(integer));
+        if (exponent < 0 && writer.remaining() > 0) {
+            // Fraction chunks below the point, padded with zeros when the number is tiny
+            const uint64_t fraction_size = -exponent;
+            VectorUtils::ChunkVector fraction(mantissa.begin(),
+                                              mantissa.begin() + std::min<uint64_t>(fraction_size, mantissa.size()));
+            fraction.resize(fraction_size, 0);
+            if (!VectorUtils::is_null(fraction)) {
+                writer.write_symbol('.');
+                VectorUtils::write_fraction_digits(writer, std::move(fraction));
+            }
         }
+        writer.flush();
+    }
+
+
+    // Adapters
+    std::string BigNumber::to_string() const {
+        std::string result;
+        write([&result](std::string_view characters) { result.append(characters); });
         return result;
     }
 
     // Other
+    void BigNumber::assign_quotient(VectorUtils::ChunkVector numerator, const VectorUtils::ChunkVector& denominator,
+                                    bool negative) {
+        // Exact integer quotient scaled so that it fills the mantissa, then truncated to it
+        const uint64_t initial_size = mantissa.size();
+        const int64_t scale = std::max<int64_t>(static_cast<int64_t>(initial_size + denominator.size())
+                                                - static_cast<int64_t>(numerator.size()) + 1, 0);
+        numerator.insert(numerator.begin(), scale, 0);
+        VectorUtils::divide_vectors(numerator, denominator);
+        mantissa = std::move(numerator);
+        const uint64_t shift = VectorUtils::normalise_mantissa(mantissa, initial_size);
+        sign = negative;
+        exponent = static_cast<int64_t>(shift) - scale;
+    }
+
+    int64_t BigNumber::binary_exponent() const {
+        // |number| in [2^(e - 1), 2^e) for a number that is not zero
+        const VectorUtils::ChunkVector top = VectorUtils::trimmed(mantissa);
+        return 64 * (exponent + static_cast<int64_t>(top.size()) - 1) + std::bit_width(top.back());
+    }
+
+    VectorUtils::SignedVector BigNumber::to_fixed(int64_t bits) const {
+        // number * 2^bits truncated towards zero
+        const VectorUtils::ChunkVector magnitude = VectorUtils::shifted_bits(VectorUtils::trimmed(mantissa),
+                                                                             64 * exponent + bits);
+        return { magnitude, sign != 0 && !magnitude.empty() };
+    }
+
+    void BigNumber::assign_scaled(const VectorUtils::ChunkVector& magnitude, int64_t shift, bool negative) {
+        // Truncated to the precision
+        const uint64_t initial_size = mantissa.size();
+        const int64_t bit_shift = (shift % 64 + 64) % 64;
+        mantissa = VectorUtils::shifted_bits(magnitude, bit_shift);
+        if (mantissa.empty()) {
+            mantissa = VectorUtils::ChunkVector(initial_size, 0);
+            sign = 0;
+            exponent = 0;
+            return;
+        }
+        const uint64_t normalised = VectorUtils::normalise_mantissa(mantissa, initial_size);
+        sign = negative;
+        exponent = (shift - bit_shift) / 64 + static_cast<int64_t>(normalised);
+    }
+
     void BigNumber::normalise() {
         if (is_zero())
             return;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "vectorutilslib/chunk_vector.h"
+#include "vectorutilslib/digit_writer.h"
 #include "vectorutilslib/vector_utils.h"
 
 #include <iostream>
@@ -8,25 +10,63 @@
 #include <complex>
 #include <algorithm>
 #include <functional>
+#include <span>
 
 #include <format>
 #include <bitset>
 
 namespace BigNumber {
 
+    template <typename>
+    class Expression;
+    template <size_t>
+    class BigFixed;
+    class BigNumberBatch;
+    struct BigNumberView;
+
     class BigNumber {
         // number = (-1)^sign * (2^64)^exponent * mantissa
      private:
         uint64_t sign;
         int64_t exponent;
-        std::vector<uint64_t> mantissa;
+        VectorUtils::ChunkVector mantissa;
 
         // Addition and subtraction
         void add_positive(const BigNumber&);
         void subtract_positive(const BigNumber&);
+        // Adds (-1)^sign * (2^64)^exponent * mantissa, taking over the chunks of the term when it is the larger
+        void add_term(uint64_t, int64_t, VectorUtils::ChunkVector);
+
+        // Multiplication and division
+        void assign_product(const BigNumber&, const BigNumber&);
+        void assign_product(const BigNumber&, uint64_t);
+        void assign_square(const BigNumber&);
+        // Adds lhs * rhs, or subtracts it with the flag set, the product rounded as lhs * rhs would be
+        void add_product(const BigNumber&, const BigNumber&, bool);
+        void add_product(const BigNumber&, uint64_t, bool);
+
+        // Comparison
+        [[nodiscard]] std::strong_ordering compare_magnitude(const BigNumber&) const;
 
         // Other
         void normalise();
+        void assign_quotient(VectorUtils::ChunkVector, const VectorUtils::ChunkVector&, bool);
+        // Fixed point conversions, number = (-1)^negative * magnitude * 2^shift
+        [[nodiscard]] int64_t binary_exponent() const;
+        [[nodiscard]] VectorUtils::SignedVector to_fixed(int64_t) const;
+        void assign_scaled(const VectorUtils::ChunkVector&, int64_t, bool);
+
+        template <typename, typename>
+        friend class Product;
+        template <typename>
+        friend class ScaledProduct;
+        template <size_t>
+        friend class BigFixed;
+        friend class BigNumberBatch;
+        friend struct BigNumberView;
+        friend size_t serialized_size(const BigNumber&);
+        friend size_t serialize(const BigNumber&, std::span<std::byte>);
+        friend size_t deserialize(BigNumber&, std::span<const std::byte>);
 
      public:
 
@@ -44,6 +84,8 @@ namespace BigNumber {
         explicit BigNumber(uint64_t, uint64_t = 128);
         BigNumber(const BigNumber&);
         BigNumber(BigNumber&&) noexcept;
+        template <typename E>
+        BigNumber(const Expression<E>&);
 
         // Getters
         [[nodiscard]] bool is_positive() const;
@@ -53,30 +95,39 @@ namespace BigNumber {
         // Direct assignment
         BigNumber& operator=(const BigNumber&);
         BigNumber& operator=(BigNumber&&) noexcept;
+        template <typename E>
+        BigNumber& operator=(const Expression<E>&);
         // Unary minus
         friend BigNumber operator-(const BigNumber&);
         // Math utils
         friend BigNumber abs(const BigNumber&);
         friend BigNumber floor(const BigNumber&);
         friend BigNumber ceil(const BigNumber&);
-        // friend BigNumber sqrt(const BigNumber&);
+        friend BigNumber sqrt(const BigNumber&);
+        friend BigNumber rsqrt(const BigNumber&);
+        friend BigNumber sqr(const BigNumber&);
+        friend BigNumber& square(BigNumber&);
         friend BigNumber pow(const BigNumber&, uint64_t);
+        friend BigNumber pow(const BigNumber&, const BigNumber&);
+        friend BigNumber exp(const BigNumber&);
+        friend BigNumber log(const BigNumber&);
+        friend BigNumber sin(const BigNumber&);
+        friend BigNumber cos(const BigNumber&);
+        friend BigNumber atan2(const BigNumber&, const BigNumber&);
         friend BigNumber arctan(const BigNumber&);
+        friend BigNumber arctan_inverse(uint64_t, uint64_t);
         friend BigNumber factorial(const BigNumber&);
 
         // Addition and subtraction
         friend BigNumber& operator+=(BigNumber&, const BigNumber&);
         friend BigNumber& operator+=(BigNumber&, uint64_t);
         friend BigNumber& operator-=(BigNumber&, const BigNumber&);
-        friend BigNumber operator+(const BigNumber&, const BigNumber&);
-        friend BigNumber operator-(const BigNumber&, const BigNumber&);
 
         // Multiplication and division
         friend BigNumber& operator*=(BigNumber&, const BigNumber&);
         friend BigNumber& operator*=(BigNumber&, uint64_t);
         friend BigNumber& operator/=(BigNumber&, const BigNumber&);
-        friend BigNumber operator*(const BigNumber&, uint64_t);
-        friend BigNumber operator*(const BigNumber&, const BigNumber&);
+        friend BigNumber& operator/=(BigNumber&, uint64_t);
         friend BigNumber operator/(const BigNumber&, const BigNumber&);
         friend BigNumber operator/(const BigNumber&, uint64_t);
 
@@ -86,12 +137,22 @@ namespace BigNumber {
 
         // Stream representation
         friend std::ostream& operator<<(std::ostream&, const BigNumber&);
+        // Writes digits in blocks as they are produced, stopping after the given number of digits
+        void write(std::ostream&, uint64_t = VectorUtils::UNLIMITED_DIGITS) const;
+        void write(const VectorUtils::DigitSink&, uint64_t = VectorUtils::UNLIMITED_DIGITS) const;
 
         // Adapters
         [[nodiscard]] std::string to_string() const;
     };
 }
 
+namespace BigNumber {
+    // arctan(1 / k) for k > 1
+    BigNumber arctan_inverse(uint64_t, uint64_t = 128);
+}
+
+#include "big_number_expression.h"
+
 // UD literals
 BigNumber::BigNumber operator""_b(const char *);
 BigNumber::BigNumber operator""_b(long double);
@@ -0,0 +1,124 @@
+#include "big_number_batch.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace BigNumber {
+
+    BigNumberBatch::BigNumberBatch(size_t size, uint64_t integer_precision, uint64_t fraction_precision) {
+        const uint64_t integer_chunks = integer_precision / 64 + (integer_precision % 64 > 0);
+        fraction_chunks = fraction_precision / 64 + (fraction_precision % 64 > 0);
+        chunks = integer_chunks + fraction_chunks;
+        if (integer_chunks == 0)
+            throw std::runtime_error("Batch needs an integer part for the sign");
+        count = size;
+        // Padding elements stay zero, so kernels run over whole lane groups
+        stride = (size + VectorUtils::BATCH_LANES - 1) / VectorUtils::BATCH_LANES * VectorUtils::BATCH_LANES;
+        limbs.resize(stride * chunks, 0);
+    }
+
+    size_t BigNumberBatch::size() const {
+        return count;
+    }
+
+    BigNumber BigNumberBatch::get(size_t index) const {
+        if (index >= count)
+            throw std::runtime_error("Batch index out of range");
+        BigNumber result(static_cast<uint64_t>(0), chunks * 64);
+        for (uint64_t j = 0; j < chunks; ++j)
+            result.mantissa[j] = limbs[j * stride + index];
+        if (result.mantissa.back() >> 63 != 0) {
+            // Two's complement magnitude
+            uint64_t carry = 1;
+            for (uint64_t& chunk : result.mantissa) {
+                chunk = ~chunk + carry;
+                carry = carry != 0 && chunk == 0;
+            }
+            result.sign = 1;
+        }
+        if (result.is_zero())
+            return result;
+        result.exponent = -static_cast<int64_t>(fraction_chunks);
+        result.normalise();
+        return result;
+    }
+
+    void BigNumberBatch::set(size_t index, const BigNumber& number) {
+        if (index >= count)
+            throw std::runtime_error("Batch index out of range");
+        // Chunk j of the element has weight (2^64)^(j - fraction_chunks), chunk i of number (2^64)^(exponent + i)
+        VectorUtils::ChunkVector element(chunks, 0);
+        const int64_t offset = number.exponent + static_cast<int64_t>(fraction_chunks);
+        for (uint64_t i = 0; i < number.mantissa.size(); ++i) {
+            const int64_t j = offset + static_cast<int64_t>(i);
+            if (j < 0 || number.mantissa[i] == 0)
+                continue;
+            if (j >= static_cast<int64_t>(chunks))
+                throw std::runtime_error("Number does not fit the batch precision");
+            element[j] = number.mantissa[i];
+        }
+        const bool is_negative = number.is_negative() && !VectorUtils::is_null(element);
+        if (element.back() >> 63 != 0) {
+            // Only the most negative number has the sign bit set in its magnitude
+            const bool is_most_negative = is_negative && element.back() == uint64_t(1) << 63
+                                          && std::all_of(element.begin(), element.end() - 1,
+                                                         [](uint64_t chunk) { return chunk == 0; });
+            if (!is_most_negative)
+                throw std::runtime_error("Number does not fit the batch precision");
+        }
+        if (is_negative) {
+            uint64_t carry = 1;
+            for (uint64_t& chunk : element) {
+                chunk = ~chunk + carry;
+                carry = carry != 0 && chunk == 0;
+            }
+        }
+        for (uint64_t j = 0; j < chunks; ++j)
+            limbs[j * stride + index] = element[j];
+    }
+
+    void BigNumberBatch::check_compatible(const BigNumberBatch& other) const {
+        if (count != other.count || chunks != other.chunks || fraction_chunks != other.fraction_chunks)
+            throw std::runtime_error("Batches differ in size or precision");
+    }
+
+    BigNumberBatch& BigNumberBatch::operator+=(const BigNumberBatch& other) {
+        check_compatible(other);
+        if (VectorUtils::add_batch(limbs.data(), other.limbs.data(), stride, chunks))
+            throw std::runtime_error("Batch addition overflowed");
+        return *this;
+    }
+
+    BigNumberBatch& BigNumberBatch::operator-=(const BigNumberBatch& other) {
+        check_compatible(other);
+        if (VectorUtils::subtract_batch(limbs.data(), other.limbs.data(), stride, chunks))
+            throw std::runtime_error("Batch subtraction overflowed");
+        return *this;
+    }
+
+    BigNumberBatch& BigNumberBatch::operator*=(int64_t number) {
+        // Negating first keeps products that are the most negative number representable
+        const uint64_t magnitude = number < 0 ? 0 - static_cast<uint64_t>(number) : static_cast<uint64_t>(number);
+        bool overflow = number < 0 && VectorUtils::negate_batch(limbs.data(), stride, chunks);
+        overflow = VectorUtils::multiply_batch(limbs.data(), magnitude, stride, chunks) || overflow;
+        if (overflow)
+            throw std::runtime_error("Batch multiplication overflowed");
+        return *this;
+    }
+
+    void BigNumberBatch::negate() {
+        if (VectorUtils::negate_batch(limbs.data(), stride, chunks))
+            throw std::runtime_error("Batch negation overflowed");
+    }
+
+    std::vector<std::strong_ordering> BigNumberBatch::compare(const BigNumberBatch& other) const {
+        check_compatible(other);
+        std::vector<int8_t> orderings(stride);
+        VectorUtils::compare_batch(limbs.data(), other.limbs.data(), orderings.data(), stride, chunks);
+        std::vector<std::strong_ordering> result;
+        result.reserve(count);
+        for (size_t i = 0; i < count; ++i)
+            result.push_back(orderings[i] <=> 0);
+        return result;
+    }
+}
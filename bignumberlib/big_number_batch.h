@@ -0,0 +1,45 @@
+#pragma once
+
+#include "big_number.h"
+#include "vectorutilslib/batch_kernels.h"
+
+#include <compare>
+#include <cstdint>
+#include <vector>
+
+namespace BigNumber {
+
+    // Many fixed point numbers of the same precision, element = two's complement integer * (2^64)^-fraction chunks.
+    // Chunks are stored limb-interleaved (chunk j of every element, then chunk j + 1) so that element-wise
+    // operations run on SIMD lanes. Operations throw when an element overflows the integer part
+    class BigNumberBatch {
+     private:
+        size_t count;
+        size_t stride;
+        uint64_t chunks;
+        uint64_t fraction_chunks;
+        VectorUtils::ChunkVector limbs;
+
+        void check_compatible(const BigNumberBatch&) const;
+
+     public:
+        // Precisions are in bits and round up to multiples of 64 like BigNumber's, one bit of the integer part
+        // holds the sign
+        BigNumberBatch(size_t, uint64_t, uint64_t);
+
+        [[nodiscard]] size_t size() const;
+
+        // Element access, set truncates fraction chunks that do not fit and throws when the integer part does not
+        [[nodiscard]] BigNumber get(size_t) const;
+        void set(size_t, const BigNumber&);
+
+        // Element-wise arithmetic
+        BigNumberBatch& operator+=(const BigNumberBatch&);
+        BigNumberBatch& operator-=(const BigNumberBatch&);
+        BigNumberBatch& operator*=(int64_t);
+        void negate();
+
+        // Element-wise comparison
+        [[nodiscard]] std::vector<std::strong_ordering> compare(const BigNumberBatch&) const;
+    };
+}
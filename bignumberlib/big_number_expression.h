@@ -0,0 +1,219 @@
+#pragma once
+
+#include "big_number.h"
+
+#include <concepts>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace BigNumber {
+
+    // Expression templates
+    // a * b + c * d - e is kept as a tree of nodes and evaluated into the destination number: the leftmost term
+    // becomes the destination and products on the right are multiplied into a chunk vector of their own that is
+    // added into it. Operands are not copied, only nested operands on either side of a product are evaluated into
+    // numbers first. Nodes refer to named numbers, so they are meant to be assigned to a number, not kept in auto
+    template <typename Derived>
+    class Expression {
+     public:
+        [[nodiscard]] const Derived& derived() const {
+            return static_cast<const Derived&>(*this);
+        }
+
+        // Members of BigNumber, evaluated into a number first
+        [[nodiscard]] bool is_positive() const { return BigNumber(*this).is_positive(); }
+        [[nodiscard]] bool is_negative() const { return BigNumber(*this).is_negative(); }
+        [[nodiscard]] bool is_zero() const { return BigNumber(*this).is_zero(); }
+        void write(std::ostream& outs, uint64_t digits = VectorUtils::UNLIMITED_DIGITS) const {
+            BigNumber(*this).write(outs, digits);
+        }
+        void write(const VectorUtils::DigitSink& sink, uint64_t digits = VectorUtils::UNLIMITED_DIGITS) const {
+            BigNumber(*this).write(sink, digits);
+        }
+        [[nodiscard]] std::string to_string() const { return BigNumber(*this).to_string(); }
+    };
+
+    template <typename T>
+    concept Operand = std::same_as<std::remove_cvref_t<T>, BigNumber>
+                      || std::derived_from<std::remove_cvref_t<T>, Expression<std::remove_cvref_t<T>>>;
+
+    // Named numbers are referenced, temporaries are moved in and nodes are held by value
+    template <typename T>
+    using Stored = std::conditional_t<std::is_lvalue_reference_v<T> && std::same_as<std::remove_cvref_t<T>, BigNumber>,
+                                      const BigNumber&, std::remove_cvref_t<T>>;
+
+    inline void evaluate(BigNumber& destination, const BigNumber& number) {
+        destination = number;
+    }
+
+    template <typename E>
+    void evaluate(BigNumber& destination, const Expression<E>& expression) {
+        expression.derived().evaluate(destination);
+    }
+
+    inline const BigNumber& value(const BigNumber& number) {
+        return number;
+    }
+
+    template <typename E>
+    BigNumber value(const Expression<E>& expression) {
+        return BigNumber(expression);
+    }
+
+    // destination += operand, or -= with negative set
+    inline void accumulate(BigNumber& destination, const BigNumber& number, bool negative) {
+        if (negative)
+            destination -= number;
+        else
+            destination += number;
+    }
+
+    template <typename E>
+    void accumulate(BigNumber& destination, const Expression<E>& expression, bool negative) {
+        expression.derived().accumulate(destination, negative);
+    }
+
+    template <typename Lhs, typename Rhs>
+    class Sum : public Expression<Sum<Lhs, Rhs>> {
+        Lhs lhs;
+        Rhs rhs;
+
+     public:
+        template <typename L, typename R>
+        Sum(L&& l, R&& r) : lhs(std::forward<L>(l)), rhs(std::forward<R>(r)) {}
+
+        void evaluate(BigNumber& destination) const {
+            ::BigNumber::evaluate(destination, lhs);
+            ::BigNumber::accumulate(destination, rhs, false);
+        }
+
+        void accumulate(BigNumber& destination, bool negative) const {
+            // Rounded as the sum on its own would be
+            ::BigNumber::accumulate(destination, BigNumber(*this), negative);
+        }
+    };
+
+    template <typename Lhs, typename Rhs>
+    class Difference : public Expression<Difference<Lhs, Rhs>> {
+        Lhs lhs;
+        Rhs rhs;
+
+     public:
+        template <typename L, typename R>
+        Difference(L&& l, R&& r) : lhs(std::forward<L>(l)), rhs(std::forward<R>(r)) {}
+
+        void evaluate(BigNumber& destination) const {
+            ::BigNumber::evaluate(destination, lhs);
+            ::BigNumber::accumulate(destination, rhs, true);
+        }
+
+        void accumulate(BigNumber& destination, bool negative) const {
+            ::BigNumber::accumulate(destination, BigNumber(*this), negative);
+        }
+    };
+
+    template <typename Lhs, typename Rhs>
+    class Product : public Expression<Product<Lhs, Rhs>> {
+        Lhs lhs;
+        Rhs rhs;
+
+     public:
+        template <typename L, typename R>
+        Product(L&& l, R&& r) : lhs(std::forward<L>(l)), rhs(std::forward<R>(r)) {}
+
+        void evaluate(BigNumber& destination) const {
+            // A number on the left is multiplied in place of being copied first
+            if constexpr (std::same_as<std::remove_cvref_t<Lhs>, BigNumber>) {
+                destination.assign_product(lhs, value(rhs));
+            } else {
+                ::BigNumber::evaluate(destination, lhs);
+                destination *= value(rhs);
+            }
+        }
+
+        void accumulate(BigNumber& destination, bool negative) const {
+            destination.add_product(value(lhs), value(rhs), negative);
+        }
+    };
+
+    template <typename Lhs>
+    class ScaledProduct : public Expression<ScaledProduct<Lhs>> {
+        Lhs lhs;
+        uint64_t number;
+
+     public:
+        template <typename L>
+        ScaledProduct(L&& l, uint64_t n) : lhs(std::forward<L>(l)), number(n) {}
+
+        void evaluate(BigNumber& destination) const {
+            if constexpr (std::same_as<std::remove_cvref_t<Lhs>, BigNumber>) {
+                destination.assign_product(lhs, number);
+            } else {
+                ::BigNumber::evaluate(destination, lhs);
+                destination *= number;
+            }
+        }
+
+        void accumulate(BigNumber& destination, bool negative) const {
+            destination.add_product(value(lhs), number, negative);
+        }
+    };
+
+    // Evaluation
+    template <typename E>
+    BigNumber::BigNumber(const Expression<E>& expression) : sign(0), exponent(0) {
+        expression.derived().evaluate(*this);
+    }
+
+    template <typename E>
+    BigNumber& BigNumber::operator=(const Expression<E>& expression) {
+        // The expression may refer to this number, so it is evaluated aside
+        BigNumber result(expression);
+        return *this = std::move(result);
+    }
+
+    // Addition and subtraction
+    template <Operand L, Operand R>
+    Sum<Stored<L>, Stored<R>> operator+(L&& lhs, R&& rhs) {
+        return { std::forward<L>(lhs), std::forward<R>(rhs) };
+    }
+
+    template <Operand L, Operand R>
+    Difference<Stored<L>, Stored<R>> operator-(L&& lhs, R&& rhs) {
+        return { std::forward<L>(lhs), std::forward<R>(rhs) };
+    }
+
+    // Multiplication and division
+    template <Operand L, Operand R>
+    Product<Stored<L>, Stored<R>> operator*(L&& lhs, R&& rhs) {
+        return { std::forward<L>(lhs), std::forward<R>(rhs) };
+    }
+
+    template <Operand L>
+    ScaledProduct<Stored<L>> operator*(L&& lhs, uint64_t number) {
+        return { std::forward<L>(lhs), number };
+    }
+
+    template <typename E>
+    BigNumber operator/(const Expression<E>& lhs, const BigNumber& rhs) {
+        BigNumber result(lhs);
+        result /= rhs;
+        return result;
+    }
+
+    template <typename E>
+    BigNumber operator/(const Expression<E>& lhs, uint64_t number) {
+        BigNumber result(lhs);
+        result /= number;
+        return result;
+    }
+
+    // Stream representation
+    template <typename E>
+    std::ostream& operator<<(std::ostream& outs, const Expression<E>& expression) {
+        return outs << BigNumber(expression);
+    }
+}
@@ -0,0 +1,216 @@
+#include "big_number_serialization.h"
+
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BIGNUMBER_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace BigNumber {
+
+    namespace {
+        const size_t NUMBER_HEADER_SIZE = 24;
+        const size_t ARRAY_HEADER_SIZE = 24;
+
+        // Byte by byte so that neither alignment nor host byte order matter, compilers turn these into single moves
+        uint64_t load_bytes(const std::byte *source, size_t bytes) {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i)
+                value |= static_cast<uint64_t>(source[i]) << (8 * i);
+            return value;
+        }
+
+        void store_bytes(std::byte *destination, uint64_t value, size_t bytes) {
+            for (size_t i = 0; i < bytes; ++i)
+                destination[i] = static_cast<std::byte>(value >> (8 * i));
+        }
+
+        struct NumberHeader {
+            uint64_t sign;
+            int64_t exponent;
+            uint64_t limbs;
+        };
+
+        NumberHeader read_header(std::span<const std::byte> bytes) {
+            if (bytes.size() < NUMBER_HEADER_SIZE)
+                throw std::runtime_error("Buffer is too small for a serialized number");
+            if (load_bytes(bytes.data(), 4) != SERIALIZATION_VERSION)
+                throw std::runtime_error("Unsupported serialization version");
+            const NumberHeader header = { load_bytes(bytes.data() + 4, 4),
+                                          static_cast<int64_t>(load_bytes(bytes.data() + 8, 8)),
+                                          load_bytes(bytes.data() + 16, 8) };
+            if (header.sign > 1 || header.limbs == 0)
+                throw std::runtime_error("Invalid serialized number");
+            if (header.limbs > (bytes.size() - NUMBER_HEADER_SIZE) / 8)
+                throw std::runtime_error("Buffer is too small for a serialized number");
+            return header;
+        }
+    }
+
+    // Numbers
+    size_t serialized_size(const BigNumber& number) {
+        return NUMBER_HEADER_SIZE + 8 * number.mantissa.size();
+    }
+
+    size_t serialize(const BigNumber& number, std::span<std::byte> bytes) {
+        const size_t size = serialized_size(number);
+        if (bytes.size() < size)
+            throw std::runtime_error("Buffer is too small for the serialized number");
+        std::byte *destination = bytes.data();
+        store_bytes(destination, SERIALIZATION_VERSION, 4);
+        store_bytes(destination + 4, number.sign, 4);
+        store_bytes(destination + 8, static_cast<uint64_t>(number.exponent), 8);
+        store_bytes(destination + 16, number.mantissa.size(), 8);
+        for (size_t i = 0; i < number.mantissa.size(); ++i)
+            store_bytes(destination + NUMBER_HEADER_SIZE + 8 * i, number.mantissa[i], 8);
+        return size;
+    }
+
+    size_t deserialize(BigNumber& number, std::span<const std::byte> bytes) {
+        const NumberHeader header = read_header(bytes);
+        number.sign = header.sign;
+        number.exponent = header.exponent;
+        number.mantissa.resize(header.limbs);
+        for (size_t i = 0; i < header.limbs; ++i)
+            number.mantissa[i] = load_bytes(bytes.data() + NUMBER_HEADER_SIZE + 8 * i, 8);
+        return NUMBER_HEADER_SIZE + 8 * header.limbs;
+    }
+
+    // Arrays
+    size_t serialized_array_size(std::span<const BigNumber> numbers) {
+        size_t size = ARRAY_HEADER_SIZE + 8 * numbers.size();
+        for (const BigNumber& number : numbers)
+            size += serialized_size(number);
+        return size;
+    }
+
+    size_t serialize_array(std::span<const BigNumber> numbers, std::span<std::byte> bytes) {
+        const size_t size = serialized_array_size(numbers);
+        if (bytes.size() < size)
+            throw std::runtime_error("Buffer is too small for the serialized array");
+        store_bytes(bytes.data(), SERIALIZATION_ARRAY_MAGIC, 8);
+        store_bytes(bytes.data() + 8, SERIALIZATION_VERSION, 4);
+        store_bytes(bytes.data() + 12, 0, 4);
+        store_bytes(bytes.data() + 16, numbers.size(), 8);
+        size_t offset = ARRAY_HEADER_SIZE + 8 * numbers.size();
+        for (size_t i = 0; i < numbers.size(); ++i) {
+            store_bytes(bytes.data() + ARRAY_HEADER_SIZE + 8 * i, offset, 8);
+            offset += serialize(numbers[i], bytes.subspan(offset));
+        }
+        return size;
+    }
+
+    // Views
+    BigNumber BigNumberView::to_number() const {
+        BigNumber result(static_cast<uint64_t>(0), 64);
+        result.sign = sign;
+        result.exponent = exponent;
+        result.mantissa = VectorUtils::ChunkVector(limbs.begin(), limbs.end());
+        return result;
+    }
+
+    BigNumberArrayView::BigNumberArrayView() : offsets(nullptr), count(0) {}
+
+    BigNumberArrayView::BigNumberArrayView(std::span<const std::byte> bytes) : data(bytes) {
+        // Only the header and the offsets are checked here, numbers when they are accessed
+        if constexpr (std::endian::native != std::endian::little)
+            throw std::runtime_error("Serialized arrays are read in place on little-endian hosts only");
+        if (reinterpret_cast<uintptr_t>(bytes.data()) % alignof(uint64_t) != 0)
+            throw std::runtime_error("Serialized array is not 8 byte aligned");
+        if (bytes.size() < ARRAY_HEADER_SIZE || load_bytes(bytes.data(), 8) != SERIALIZATION_ARRAY_MAGIC)
+            throw std::runtime_error("Buffer does not hold a serialized array");
+        if (load_bytes(bytes.data() + 8, 4) != SERIALIZATION_VERSION || load_bytes(bytes.data() + 12, 4) != 0)
+            throw std::runtime_error("Unsupported serialization version");
+        count = load_bytes(bytes.data() + 16, 8);
+        if (count > (bytes.size() - ARRAY_HEADER_SIZE) / 8)
+            throw std::runtime_error("Invalid serialized array");
+        offsets = reinterpret_cast<const uint64_t *>(bytes.data() + ARRAY_HEADER_SIZE);
+        const uint64_t numbers_offset = ARRAY_HEADER_SIZE + 8 * count;
+        for (size_t i = 0; i < count; ++i) {
+            if (offsets[i] < numbers_offset || offsets[i] % 8 != 0 || offsets[i] > bytes.size())
+                throw std::runtime_error("Invalid serialized array");
+        }
+    }
+
+    size_t BigNumberArrayView::size() const {
+        return count;
+    }
+
+    BigNumberView BigNumberArrayView::operator[](size_t index) const {
+        if (index >= count)
+            throw std::runtime_error("Array index out of range");
+        const std::span<const std::byte> bytes = data.subspan(offsets[index]);
+        const NumberHeader header = read_header(bytes);
+        const auto *limbs = reinterpret_cast<const uint64_t *>(bytes.data() + NUMBER_HEADER_SIZE);
+        return { header.sign, header.exponent, std::span<const uint64_t>(limbs, header.limbs) };
+    }
+
+    BigNumber BigNumberArrayView::get(size_t index) const {
+        return (*this)[index].to_number();
+    }
+
+    // Mapped files
+    MappedBigNumberArray::MappedBigNumberArray(const std::string& path) : address(nullptr), length(0) {
+#ifdef BIGNUMBER_MMAP
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            throw std::runtime_error("Cannot open " + path);
+        struct stat status {};
+        if (::fstat(file, &status) != 0 || status.st_size < static_cast<off_t>(ARRAY_HEADER_SIZE)) {
+            ::close(file);
+            throw std::runtime_error("Buffer does not hold a serialized array");
+        }
+        length = status.st_size;
+        void *mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if (mapping == MAP_FAILED)
+            throw std::runtime_error("Cannot map " + path);
+        address = static_cast<const std::byte *>(mapping);
+        try {
+            numbers = BigNumberArrayView(std::span<const std::byte>(address, length));
+        } catch (...) {
+            ::munmap(mapping, length);
+            throw;
+        }
+#else
+        // Read the whole file into 8 byte aligned storage instead
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            throw std::runtime_error("Cannot open " + path);
+        length = file.tellg();
+        fallback.resize(length / 8 + 1);
+        file.seekg(0);
+        file.read(reinterpret_cast<char *>(fallback.data()), static_cast<std::streamsize>(length));
+        address = reinterpret_cast<const std::byte *>(fallback.data());
+        numbers = BigNumberArrayView(std::span<const std::byte>(address, length));
+#endif
+    }
+
+    MappedBigNumberArray::~MappedBigNumberArray() {
+#ifdef BIGNUMBER_MMAP
+        ::munmap(const_cast<std::byte *>(address), length);
+#endif
+    }
+
+    size_t MappedBigNumberArray::size() const {
+        return numbers.size();
+    }
+
+    BigNumberView MappedBigNumberArray::operator[](size_t index) const {
+        return numbers[index];
+    }
+
+    BigNumber MappedBigNumberArray::get(size_t index) const {
+        return numbers.get(index);
+    }
+
+    const BigNumberArrayView& MappedBigNumberArray::view() const {
+        return numbers;
+    }
+}
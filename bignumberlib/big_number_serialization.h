@@ -0,0 +1,75 @@
+#pragma once
+
+#include "big_number.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace BigNumber {
+
+    // Binary format, all fields little-endian:
+    //   number: uint32 version, uint32 sign, int64 exponent, uint64 limb count, limbs from the least significant one
+    //   array:  uint64 magic, uint32 version, uint32 zero, uint64 count, uint64 byte offset of each number, numbers
+    // Numbers keep their whole mantissa, so they come back with the same precision. Records are multiples of 8
+    // bytes, limbs of an array that is 8 byte aligned can be read in place
+    const uint32_t SERIALIZATION_VERSION = 1;
+    const uint64_t SERIALIZATION_ARRAY_MAGIC = 0x5352'424D'554E'4742;   // "BGNUMBRS"
+
+    [[nodiscard]] size_t serialized_size(const BigNumber&);
+    // Return the bytes written or read, throw when the buffer is too small or does not hold a valid number
+    size_t serialize(const BigNumber&, std::span<std::byte>);
+    size_t deserialize(BigNumber&, std::span<const std::byte>);
+
+    [[nodiscard]] size_t serialized_array_size(std::span<const BigNumber>);
+    size_t serialize_array(std::span<const BigNumber>, std::span<std::byte>);
+
+    // A number whose limbs live in someone else's memory
+    struct BigNumberView {
+        uint64_t sign;
+        int64_t exponent;
+        std::span<const uint64_t> limbs;
+
+        [[nodiscard]] BigNumber to_number() const;
+    };
+
+    // Read-only numbers of a serialized array, validated once on construction and read in place afterwards.
+    // Needs a little-endian host and an 8 byte aligned buffer that outlives the view
+    class BigNumberArrayView {
+     private:
+        std::span<const std::byte> data;
+        const uint64_t *offsets;
+        size_t count;
+
+     public:
+        BigNumberArrayView();
+        explicit BigNumberArrayView(std::span<const std::byte>);
+
+        [[nodiscard]] size_t size() const;
+        // Both throw for an index out of range or an invalid number, get copies the limbs into a number
+        [[nodiscard]] BigNumberView operator[](size_t) const;
+        [[nodiscard]] BigNumber get(size_t) const;
+    };
+
+    // A serialized array file mapped into memory read-only, numbers are paged in on first access
+    class MappedBigNumberArray {
+     private:
+        const std::byte *address;
+        size_t length;
+        std::vector<uint64_t> fallback;
+        BigNumberArrayView numbers;
+
+     public:
+        explicit MappedBigNumberArray(const std::string&);
+        ~MappedBigNumberArray();
+        MappedBigNumberArray(const MappedBigNumberArray&) = delete;
+        MappedBigNumberArray& operator=(const MappedBigNumberArray&) = delete;
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] BigNumberView operator[](size_t) const;
+        [[nodiscard]] BigNumber get(size_t) const;
+        [[nodiscard]] const BigNumberArrayView& view() const;
+    };
+}
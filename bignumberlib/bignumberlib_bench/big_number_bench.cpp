@@ -0,0 +1,208 @@
+#include "benchmark/benchmark.h"
+#include "big_number.h"
+
+#include <cstdint>
+#include <string>
+
+// Precisions are in bits, operands fill their whole mantissa
+namespace {
+    BigNumber::BigNumber operand(uint64_t precision, uint64_t number) {
+        return BigNumber::BigNumber(number, precision) / 7;
+    }
+
+    std::string digits(uint64_t precision) {
+        // Decimal string of about the given precision, 0.3 digits per bit
+        std::string result(precision * 3 / 10 + 1, '7');
+        result[result.size() / 2] = '.';
+        return result;
+    }
+
+    void precisions(benchmark::internal::Benchmark *benchmark) {
+        benchmark->RangeMultiplier(8)->Range(128, 1 << 21);
+    }
+
+    // Operations that grow faster than n log n are capped
+    void small_precisions(benchmark::internal::Benchmark *benchmark) {
+        benchmark->RangeMultiplier(8)->Range(128, 1 << 15);
+    }
+}
+
+// Constructors
+static void BM_ConstructUint64(benchmark::State& state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BigNumber::BigNumber(static_cast<uint64_t>(1234567890123456789), state.range(0)));
+}
+BENCHMARK(BM_ConstructUint64)->Apply(precisions);
+
+static void BM_ConstructDouble(benchmark::State& state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BigNumber::BigNumber(123.613037109375, state.range(0)));
+}
+BENCHMARK(BM_ConstructDouble)->Apply(precisions);
+
+static void BM_ConstructString(benchmark::State& state) {
+    const std::string number = digits(state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BigNumber::BigNumber(number.c_str(), state.range(0)));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * number.size()));
+}
+BENCHMARK(BM_ConstructString)->Apply(precisions);
+
+static void BM_Copy(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BigNumber::BigNumber(a));
+}
+BENCHMARK(BM_Copy)->Apply(precisions);
+
+// Addition and subtraction
+static void BM_Add(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    const BigNumber::BigNumber b = operand(state.range(0), 5);
+    for (auto _ : state) {
+        BigNumber::BigNumber c = a + b;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_Add)->Apply(precisions);
+
+static void BM_Subtract(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    const BigNumber::BigNumber b = operand(state.range(0), 5);
+    for (auto _ : state) {
+        BigNumber::BigNumber c = a - b;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_Subtract)->Apply(precisions);
+
+// Multiplication and division
+static void BM_Multiply(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    const BigNumber::BigNumber b = operand(state.range(0), 5);
+    for (auto _ : state) {
+        BigNumber::BigNumber c = a * b;
+        benchmark::DoNotOptimize(c);
+    }
+}
+BENCHMARK(BM_Multiply)->Apply(precisions);
+
+static void BM_Square(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sqr(a));
+}
+BENCHMARK(BM_Square)->Apply(precisions);
+
+static void BM_Divide(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    const BigNumber::BigNumber b = operand(state.range(0), 5);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a / b);
+}
+BENCHMARK(BM_Divide)->Apply(precisions);
+
+static void BM_DivideByNumber(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a / 10);
+}
+BENCHMARK(BM_DivideByNumber)->Apply(precisions);
+
+// Comparison
+static void BM_Compare(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    const BigNumber::BigNumber b = BigNumber::BigNumber(a);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a <=> b);
+}
+BENCHMARK(BM_Compare)->Apply(precisions);
+
+// Math
+static void BM_Pow(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pow(a, 100));
+}
+BENCHMARK(BM_Pow)->Apply(precisions);
+
+static void BM_Sqrt(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sqrt(a));
+}
+BENCHMARK(BM_Sqrt)->Apply(precisions);
+
+static void BM_Rsqrt(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(rsqrt(a));
+}
+BENCHMARK(BM_Rsqrt)->Apply(precisions);
+
+static void BM_Arctan(benchmark::State& state) {
+    const BigNumber::BigNumber a = BigNumber::BigNumber(1, state.range(0)) / 5;
+    for (auto _ : state)
+        benchmark::DoNotOptimize(arctan(a));
+}
+BENCHMARK(BM_Arctan)->Apply(small_precisions);
+
+static void BM_ArctanInverse(benchmark::State& state) {
+    for (auto _ : state)
+        benchmark::DoNotOptimize(BigNumber::arctan_inverse(5, state.range(0)));
+}
+BENCHMARK(BM_ArctanInverse)->Apply(precisions);
+
+static void BM_Exp(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(exp(a));
+}
+BENCHMARK(BM_Exp)->Apply(small_precisions);
+
+static void BM_Log(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(log(a));
+}
+BENCHMARK(BM_Log)->Apply(small_precisions);
+
+static void BM_Sin(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(sin(a));
+}
+BENCHMARK(BM_Sin)->Apply(small_precisions);
+
+static void BM_Atan2(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    const BigNumber::BigNumber b = operand(state.range(0), 5);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(atan2(a, b));
+}
+BENCHMARK(BM_Atan2)->Apply(small_precisions);
+
+static void BM_RealPow(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    const BigNumber::BigNumber b = operand(state.range(0), 5);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(pow(a, b));
+}
+BENCHMARK(BM_RealPow)->Apply(small_precisions);
+
+static void BM_Factorial(benchmark::State& state) {
+    // n! has about n log2(n / e) bits, the argument is sized to fill the precision
+    const uint64_t n = std::max<uint64_t>(state.range(0) / 8, 2);
+    const BigNumber::BigNumber a(n, state.range(0));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(factorial(a));
+}
+BENCHMARK(BM_Factorial)->Apply(precisions);
+
+// Adapters
+static void BM_ToString(benchmark::State& state) {
+    const BigNumber::BigNumber a = operand(state.range(0), 3);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(a.to_string());
+}
+BENCHMARK(BM_ToString)->Apply(precisions);
@@ -1,8 +1,16 @@
 #include "gtest/gtest.h"
 #include "big_number.h"
+#include "big_fixed.h"
+#include "big_number_batch.h"
+#include "big_number_serialization.h"
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
 
 const uint64_t precision = 10 * 64;
 
@@ -23,6 +31,15 @@ TEST(BigNumberTest, NegativeStringConstructor) {
     EXPECT_EQ("-12345678901234567890123456789.12345678901234567890123456789", c.to_string());
 }
 
+TEST(BigNumberTest, LongFractionStringConstructor) {
+    // 2^-300 has an exact binary representation
+    const char *s = "0.0000000000000000000000000000000000000000000000000000000000000000000000000000000000000000004909093465"
+                    "2977265530957719549862756429752155124994495651115491171871052547217158564600978840373319522771835715"
+                    "6513187851316791861042471890280751482410896345225310546445986192853894181098439730703830718994140625";
+    BigNumber::BigNumber a(s, precision);
+    EXPECT_EQ(s, a.to_string());
+}
+
 TEST(BigNumberTest, NegativeDoubleConstructor) {
     BigNumber::BigNumber d(-123.613037109375, precision);
     EXPECT_EQ("-123.613037109375", d.to_string());
@@ -173,11 +190,35 @@ TEST(BigNumberTest, Ceil) {
     EXPECT_EQ("-12345678901234567890123456789", h.to_string());
 }
 
-// TEST(BigNumberTest, Sqrt) {
-//     BigNumber::BigNumber a("1522756", precision);
-//     BigNumber::BigNumber b = sqrt(a);
-//     EXPECT_EQ("1234", b.to_string());
-// }
+TEST(BigNumberTest, Sqrt) {
+    BigNumber::BigNumber a("1522756", precision);
+    BigNumber::BigNumber b = sqrt(a);
+    EXPECT_EQ("1234", b.to_string());
+
+    BigNumber::BigNumber c = sqrt(BigNumber::BigNumber(2, precision));
+    EXPECT_EQ("1.41421356237309504880168872420969807856967187537694", c.to_string().substr(0, 52));
+    EXPECT_GE(BigNumber::BigNumber(2, precision), c * c);
+    // Correct to the last of the nine fraction chunks, 2 - c * c is below 2 * sqrt(2) + 1 units of 2^-576
+    const BigNumber::BigNumber units = BigNumber::BigNumber(1, precision) / pow(BigNumber::BigNumber(2, precision), 574);
+    EXPECT_GT(units, BigNumber::BigNumber(2, precision) - c * c);
+    BigNumber::BigNumber d = sqrt(BigNumber::BigNumber("0.0625", precision));
+    EXPECT_EQ("0.25", d.to_string());
+    BigNumber::BigNumber e = sqrt(BigNumber::BigNumber(3, 4096 * 64) * BigNumber::BigNumber(3, 4096 * 64) / 7);
+    EXPECT_EQ("1.1338934190276816816", e.to_string().substr(0, 21));
+    EXPECT_TRUE(sqrt(BigNumber::BigNumber(0, precision)).is_zero());
+    EXPECT_THROW(sqrt(BigNumber::BigNumber(-4, precision)), std::runtime_error);
+}
+
+TEST(BigNumberTest, Rsqrt) {
+    BigNumber::BigNumber a = rsqrt(BigNumber::BigNumber(4, precision));
+    EXPECT_EQ("0.5", a.to_string());
+    BigNumber::BigNumber b = rsqrt(BigNumber::BigNumber(2, precision));
+    EXPECT_EQ("0.70710678118654752440084436210484903928483593768847", b.to_string().substr(0, 52));
+    BigNumber::BigNumber c = rsqrt(BigNumber::BigNumber(9, precision));
+    EXPECT_EQ("0.33333333333333333333333333333333333333333333333333", c.to_string().substr(0, 52));
+    EXPECT_THROW(rsqrt(BigNumber::BigNumber(0, precision)), std::runtime_error);
+    EXPECT_THROW(rsqrt(BigNumber::BigNumber(-4, precision)), std::runtime_error);
+}
 
 TEST(BigNumberTest, Pow) {
     BigNumber::BigNumber a("12345678901234567890123456789012345678901234567890", precision);
@@ -186,18 +227,152 @@ TEST(BigNumberTest, Pow) {
         .to_string());
 }
 
+TEST(BigNumberTest, RealPow) {
+    BigNumber::BigNumber a = pow(BigNumber::BigNumber(2, precision), BigNumber::BigNumber(1, precision) / 2);
+    EXPECT_EQ("1.41421356237309504880168872420969807856967187537694", a.to_string().substr(0, 52));
+    BigNumber::BigNumber b = pow(BigNumber::BigNumber(10, precision), BigNumber::BigNumber(1, precision) / 3);
+    EXPECT_EQ("2.15443469003188372175929356651935049525934494219210", b.to_string().substr(0, 52));
+    BigNumber::BigNumber c = pow(BigNumber::BigNumber(3, precision) / 2, BigNumber::BigNumber(5, precision) / 2);
+    EXPECT_EQ("2.75567596063107536047194458404412781596169091573875", c.to_string().substr(0, 52));
+    EXPECT_EQ("0.125", pow(BigNumber::BigNumber(2, precision), BigNumber::BigNumber(-3, precision)).to_string());
+    EXPECT_EQ("-8", pow(BigNumber::BigNumber(-2, precision), BigNumber::BigNumber(3, precision)).to_string());
+    EXPECT_THROW(pow(BigNumber::BigNumber(-8, precision), BigNumber::BigNumber(1, precision) / 3), std::runtime_error);
+    EXPECT_THROW(pow(BigNumber::BigNumber(0, precision), BigNumber::BigNumber(-1, precision)), std::runtime_error);
+    for (const uint64_t bits : { precision, uint64_t(64 * 64) }) {
+        const BigNumber::BigNumber tiny = BigNumber::BigNumber(1, bits) / pow(BigNumber::BigNumber(10, bits), 40);
+        EXPECT_EQ("1." + std::string(40, '0') + "693147180559945309417232121458176568075524157010951",
+                  pow(BigNumber::BigNumber(2, bits), tiny).to_string().substr(0, 93));
+    }
+}
+
+TEST(BigNumberTest, Exp) {
+    BigNumber::BigNumber a = exp(BigNumber::BigNumber(1, precision));
+    EXPECT_EQ("2.71828182845904523536028747135266249775724709369995", a.to_string().substr(0, 52));
+    BigNumber::BigNumber b = exp(BigNumber::BigNumber(-1, precision));
+    EXPECT_EQ("0.36787944117144232159552377016146086744581113103176", b.to_string().substr(0, 52));
+    BigNumber::BigNumber c = exp(BigNumber::BigNumber(-100, precision));
+    EXPECT_EQ(std::string(45, '0').replace(1, 1, ".") + "37200759760208359629596958038631183373588922923767",
+              c.to_string().substr(0, 95));
+    EXPECT_EQ("1", exp(BigNumber::BigNumber(0, precision)).to_string());
+    EXPECT_THROW(exp(pow(BigNumber::BigNumber(2, precision), 70)), std::runtime_error);
+    const BigNumber::BigNumber tiny = BigNumber::BigNumber(1, precision) / pow(BigNumber::BigNumber(10, precision), 40);
+    EXPECT_EQ("1." + std::string(39, '0') + "1" + std::string(40, '0') + "5" + std::string(39, '0') + "166666",
+              exp(tiny).to_string().substr(0, 128));
+}
+
+TEST(BigNumberTest, Log) {
+    BigNumber::BigNumber a = log(BigNumber::BigNumber(2, precision));
+    EXPECT_EQ("0.69314718055994530941723212145817656807550013436025", a.to_string().substr(0, 52));
+    BigNumber::BigNumber b = log(BigNumber::BigNumber(1, precision) / 1000);
+    EXPECT_EQ("-6.90775527898213705205397436405309262280330446588631", b.to_string().substr(0, 53));
+    BigNumber::BigNumber c = log(pow(BigNumber::BigNumber(10, precision), 30));
+    EXPECT_EQ("69.0775527898213705205397436405309262280330446588631", c.to_string().substr(0, 52));
+    EXPECT_TRUE(log(BigNumber::BigNumber(1, precision)).is_zero());
+    EXPECT_THROW(log(BigNumber::BigNumber(0, precision)), std::runtime_error);
+    EXPECT_THROW(log(BigNumber::BigNumber(-1, precision)), std::runtime_error);
+}
+
+TEST(BigNumberTest, SinCos) {
+    BigNumber::BigNumber a = sin(BigNumber::BigNumber(1, precision));
+    EXPECT_EQ("0.84147098480789650665250232163029899962256306079837", a.to_string().substr(0, 52));
+    BigNumber::BigNumber b = cos(BigNumber::BigNumber(1, precision));
+    EXPECT_EQ("0.54030230586813971740093660744297660373231042061792", b.to_string().substr(0, 52));
+    BigNumber::BigNumber c = sin(BigNumber::BigNumber(-10, precision));
+    EXPECT_EQ("0.54402111088936981340474766185137728168364301291622", c.to_string().substr(0, 52));
+    BigNumber::BigNumber d = cos(BigNumber::BigNumber(10, precision));
+    EXPECT_EQ("-0.83907152907645245225886394782406483451993016513316", d.to_string().substr(0, 53));
+    BigNumber::BigNumber e = sin(BigNumber::BigNumber(1000000, precision));
+    EXPECT_EQ("-0.34999350217129295211765248678077146906140660532871", e.to_string().substr(0, 53));
+    EXPECT_TRUE(sin(BigNumber::BigNumber(0, precision)).is_zero());
+    EXPECT_EQ("1", cos(BigNumber::BigNumber(0, precision)).to_string());
+    const BigNumber::BigNumber tiny = BigNumber::BigNumber(1, precision) / pow(BigNumber::BigNumber(10, precision), 40);
+    EXPECT_EQ("0." + std::string(40, '0') + std::string(80, '9') + "833333", sin(tiny).to_string().substr(0, 128));
+    EXPECT_EQ("0." + std::string(80, '9') + "5", cos(tiny).to_string().substr(0, 83));
+}
+
+TEST(BigNumberTest, Atan2) {
+    BigNumber::BigNumber one(1, precision);
+    BigNumber::BigNumber a = atan2(-one, -one);
+    EXPECT_EQ("-2.35619449019234492884698253745962716314787704953132", a.to_string().substr(0, 53));
+    BigNumber::BigNumber b = atan2(one, BigNumber::BigNumber(3, precision));
+    EXPECT_EQ("0.32175055439664219340140461435866131902075529555765", b.to_string().substr(0, 52));
+    BigNumber::BigNumber c = atan2(one, BigNumber::BigNumber(-2, precision));
+    EXPECT_EQ("2.67794504458898712224838715181828848216863234508898", c.to_string().substr(0, 52));
+    BigNumber::BigNumber d = atan2(BigNumber::BigNumber(0, precision), -one);
+    EXPECT_EQ("3.14159265358979323846264338327950288419716939937510", d.to_string().substr(0, 52));
+    EXPECT_TRUE(atan2(BigNumber::BigNumber(0, precision), one).is_zero());
+    EXPECT_TRUE(atan2(BigNumber::BigNumber(0, precision), BigNumber::BigNumber(0, precision)).is_zero());
+    // Angles close to 0 keep the relative precision
+    for (const uint64_t bits : { uint64_t(4 * 64), precision }) {
+        const BigNumber::BigNumber unit(1, bits);
+        const BigNumber::BigNumber e = atan2(unit / pow(BigNumber::BigNumber(10, bits), 30), unit);
+        EXPECT_EQ("0." + std::string(30, '0') + std::string(40, '9'), e.to_string().substr(0, 72));
+    }
+    const BigNumber::BigNumber tiny = one / pow(BigNumber::BigNumber(10, precision), 40);
+    EXPECT_EQ("0." + std::string(40, '0') + std::string(80, '9') + "666666",
+              atan2(tiny, one).to_string().substr(0, 128));
+}
+
 TEST(BigNumberTest, Arctan) {
     BigNumber::BigNumber a("0.5", precision);
     BigNumber::BigNumber b = arctan(a);
     EXPECT_EQ("0.463647609000806", b.to_string());
 }
 
+TEST(BigNumberTest, ArctanInverse) {
+    BigNumber::BigNumber pi = BigNumber::BigNumber(48, precision) * BigNumber::arctan_inverse(18, precision)
+                              + BigNumber::BigNumber(32, precision) * BigNumber::arctan_inverse(57, precision)
+                              - BigNumber::BigNumber(20, precision) * BigNumber::arctan_inverse(239, precision);
+    EXPECT_EQ("3.14159265358979323846264338327950288419716939937510", pi.to_string().substr(0, 52));
+    EXPECT_THROW(BigNumber::arctan_inverse(1, precision), std::runtime_error);
+}
+
 TEST(BigNumberTest, Factorial) {
     BigNumber::BigNumber a("5", precision);
     BigNumber::BigNumber b = factorial(a);
     EXPECT_EQ("120", b.to_string());
 }
 
+TEST(BigNumberTest, ParallelSplitting) {
+    const size_t threads = BigNumber::VectorUtils::thread_count();
+    BigNumber::BigNumber a(1000, 140 * 64);
+    BigNumber::VectorUtils::set_thread_count(1);
+    const std::string sequential_factorial = factorial(a).to_string();
+    const std::string sequential_arctan = BigNumber::arctan_inverse(57, 3000 * 64).to_string();
+    BigNumber::VectorUtils::set_thread_count(4);
+    EXPECT_EQ(sequential_factorial, factorial(a).to_string());
+    EXPECT_EQ(sequential_arctan, BigNumber::arctan_inverse(57, 3000 * 64).to_string());
+    EXPECT_EQ(2568, sequential_factorial.size());
+    EXPECT_EQ("402387260077093773543702433923003985719374864210", sequential_factorial.substr(0, 48));
+    EXPECT_THROW(BigNumber::VectorUtils::fork_join([] {}, [] { throw std::runtime_error("right"); }),
+                 std::runtime_error);
+    BigNumber::VectorUtils::set_thread_count(threads);
+}
+
+TEST(BigNumberTest, ParallelMultiplication) {
+    const size_t threads = BigNumber::VectorUtils::thread_count();
+    BigNumber::VectorUtils::set_thread_count(4);
+    // Toom-3, NTT and unbalanced products above the parallel threshold
+    for (const auto& [lhs, rhs] : { std::pair(25000, 25000), std::pair(50000, 50000), std::pair(40000, 5000) }) {
+        const BigNumber::BigNumber a(std::string(lhs, '9').c_str(), 2 * 2800 * 64);
+        const BigNumber::BigNumber b(std::string(rhs, '9').c_str(), 2800 * 64);
+        const auto product = [&a, &b] {
+            BigNumber::BigNumber c = a * b;
+            return c.to_string();
+        };
+        const std::string expected = std::string(rhs - 1, '9') + "8" + std::string(lhs - rhs, '9')
+                                     + std::string(rhs - 1, '0') + "1";
+        EXPECT_EQ(expected, product());
+        {
+            BigNumber::VectorUtils::ScopedThreadLimit limit(1);
+            EXPECT_EQ(expected, product());
+        }
+        BigNumber::VectorUtils::ScopedThreadLimit limit(3);
+        EXPECT_EQ(expected, product());
+    }
+    BigNumber::VectorUtils::set_thread_count(threads);
+}
+
 // Addition and subtraction
 TEST(BigNumberTest, Add) {
     BigNumber::BigNumber a("12345678901234567890123456789012345678901234567890", precision);
@@ -213,6 +388,24 @@ TEST(BigNumberTest, AddNegative) {
     EXPECT_EQ("0", c.to_string());
 }
 
+TEST(BigNumberTest, AddLargerNegative) {
+    BigNumber::BigNumber a("1", precision);
+    BigNumber::BigNumber b("-5.5", precision);
+    BigNumber::BigNumber c = a + b;
+    EXPECT_EQ("-4.5", c.to_string());
+}
+
+TEST(BigNumberTest, AddMixedPrecision) {
+    BigNumber::BigNumber a("6277101735386680763835789423207666416102355444464034512897", 4 * 64);
+    BigNumber::BigNumber b("0.5", 64);
+    BigNumber::BigNumber c = a + b;
+    EXPECT_EQ("6277101735386680763835789423207666416102355444464034512897", c.to_string());
+    c = a - b;
+    EXPECT_EQ("6277101735386680763835789423207666416102355444464034512896", c.to_string());
+    c = b + a;
+    EXPECT_EQ("6277101735386680763835789423207666416102355444464034512896", c.to_string());
+}
+
 TEST(BigNumberTest, Sub) {
     BigNumber::BigNumber a("123456789012345678901234567890.12345678901234567890", precision);
     BigNumber::BigNumber b("123456789012345678901234567890.12345678901234567890", precision);
@@ -229,6 +422,34 @@ TEST(BigNumberTest, Mul) {
         .to_string());
 }
 
+TEST(BigNumberTest, Expression) {
+    BigNumber::BigNumber a("123456789", precision);
+    BigNumber::BigNumber b("-1000", precision);
+    BigNumber::BigNumber c("7", precision);
+    BigNumber::BigNumber d = a * b + c * 3 - a;
+    EXPECT_EQ("-123580245768", d.to_string());
+    EXPECT_TRUE(a * c == BigNumber::BigNumber("864197523", precision));
+    // Products on the right added into the destination, larger than it or of the other sign
+    EXPECT_EQ("-864197502", BigNumber::BigNumber(c * 3 - a * c).to_string());
+    EXPECT_EQ("123456789007", BigNumber::BigNumber(c - a * b).to_string());
+    EXPECT_EQ("-123456782", BigNumber::BigNumber(c - a * 1).to_string());
+
+    // Members of BigNumber on expressions
+    EXPECT_EQ("-123456789000", (a * b).to_string());
+    EXPECT_TRUE((a + b - a - b).is_zero());
+    EXPECT_TRUE((b * c).is_negative());
+    EXPECT_FALSE((a - c).is_negative());
+    std::ostringstream out;
+    (a * c).write(out);
+    EXPECT_EQ("864197523", out.str());
+
+    // Right hand side refers to the destination
+    a = a * c + a;
+    EXPECT_EQ("987654312", a.to_string());
+    a += b * b;
+    EXPECT_EQ("988654312", a.to_string());
+}
+
 TEST(BigNumberTest, AssignMul) {
     BigNumber::BigNumber a("12345678901234567890123456789012345678901234567890", precision);
     BigNumber::BigNumber b("12345678901234567890123456789012345678901234567890", precision);
@@ -237,6 +458,48 @@ TEST(BigNumberTest, AssignMul) {
         .to_string());
 }
 
+TEST(BigNumberTest, KaratsubaMul) {
+    BigNumber::BigNumber a(std::string(1500, '9').c_str(), 160 * 64);
+    const BigNumber::BigNumber copy = a;
+    BigNumber::BigNumber b = a * copy;
+    EXPECT_EQ(std::string(1499, '9') + "8" + std::string(1499, '0') + "1", b.to_string());
+}
+
+TEST(BigNumberTest, Toom3Mul) {
+    BigNumber::BigNumber a(std::string(5000, '9').c_str(), 600 * 64);
+    const BigNumber::BigNumber copy = a;
+    BigNumber::BigNumber b = a * copy;
+    EXPECT_EQ(std::string(4999, '9') + "8" + std::string(4999, '0') + "1", b.to_string());
+}
+
+TEST(BigNumberTest, NttMul) {
+    BigNumber::BigNumber a(std::string(20000, '9').c_str(), 2100 * 64);
+    const BigNumber::BigNumber copy = a;
+    BigNumber::BigNumber b = a * copy;
+    EXPECT_EQ(std::string(19999, '9') + "8" + std::string(19999, '0') + "1", b.to_string());
+}
+
+TEST(BigNumberTest, Sqr) {
+    for (const auto& [digits, size] : { std::pair(30, 4), std::pair(1500, 160), std::pair(5000, 600),
+                                        std::pair(20000, 2100) }) {
+        BigNumber::BigNumber a(std::string(digits, '9').c_str(), size * 64);
+        const std::string expected = std::string(digits - 1, '9') + "8" + std::string(digits - 1, '0') + "1";
+        EXPECT_EQ(expected, sqr(a).to_string());
+        EXPECT_EQ(expected, square(a).to_string());
+    }
+    BigNumber::BigNumber b("-1.5", precision);
+    EXPECT_EQ("2.25", sqr(b).to_string());
+    constexpr BigNumber::BigFixed<3> c = sqr(BigNumber::BigFixed<3>(-3) / 2);
+    static_assert(c == BigNumber::BigFixed<3>(9) / 4);
+}
+
+TEST(BigNumberTest, UnbalancedMul) {
+    BigNumber::BigNumber a(std::string(2500, '9').c_str(), 300 * 64);
+    BigNumber::BigNumber b(std::string(1200, '9').c_str(), 80 * 64);
+    a *= b;
+    EXPECT_EQ(std::string(1199, '9') + "8" + std::string(1300, '9') + std::string(1199, '0') + "1", a.to_string());
+}
+
 TEST(BigNumberTest, Div) {
     BigNumber::BigNumber a("123456789012345678901234567890123456.78901234567890", precision);
     BigNumber::BigNumber b("123456789012345678901234567890123456.78901234567890", precision);
@@ -244,10 +507,73 @@ TEST(BigNumberTest, Div) {
     EXPECT_EQ("1", c.to_string());
 }
 
+TEST(BigNumberTest, NewtonDiv) {
+    BigNumber::BigNumber a(std::string(3000, '9').c_str(), 400 * 64);
+    BigNumber::BigNumber b = a * a;
+    BigNumber::BigNumber c = b / a;
+    EXPECT_EQ(std::string(3000, '9'), c.to_string());
+}
+
+TEST(BigNumberTest, DivideShortDividend) {
+    using BigNumber::VectorUtils::ChunkVector;
+    // Divisors below and above NEWTON_DIVISION_THRESHOLD, dividends one and more chunks shorter
+    for (const uint64_t divisor_size : { 4, 250 }) {
+        const ChunkVector divisor(divisor_size, 7);
+        for (const uint64_t dividend_size : { divisor_size - 1, uint64_t(3) }) {
+            ChunkVector dividend(dividend_size, 5);
+            const ChunkVector remainder = BigNumber::VectorUtils::divide_vectors(dividend, divisor);
+            EXPECT_TRUE(BigNumber::VectorUtils::trimmed(dividend).empty());
+            EXPECT_EQ(ChunkVector(dividend_size, 5), remainder);
+        }
+    }
+}
+
+TEST(BigNumberTest, DivByNumber) {
+    BigNumber::BigNumber a("123456789012345678901234567890", precision);
+    BigNumber::BigNumber b = a / 10;
+    EXPECT_EQ("12345678901234567890123456789", b.to_string());
+
+    BigNumber::BigNumber c("-1", precision);
+    BigNumber::BigNumber d = c / 4;
+    EXPECT_EQ("-0.25", d.to_string());
+}
+
+TEST(BigNumberTest, AssignDivByNumber) {
+    BigNumber::BigNumber a("370370367037037036703703703670", precision);
+    a /= 3;
+    EXPECT_EQ("123456789012345678901234567890", a.to_string());
+
+    BigNumber::BigNumber b("36893488147419103230", precision);
+    b /= 18446744073709551615u;
+    EXPECT_EQ("2", b.to_string());
+}
+
 TEST(BigNumberTest, DivByZero) {
     BigNumber::BigNumber a("12345678901234567890123456789012345678901234567890", precision);
     BigNumber::BigNumber b("0", precision);
     EXPECT_ANY_THROW(a / b);
+    EXPECT_ANY_THROW(a / 0);
+}
+
+TEST(BigNumberTest, LimbKernels) {
+    const BigNumber::VectorUtils::LimbKernels supported = BigNumber::VectorUtils::supported_limb_kernels();
+    for (const auto kernels : { BigNumber::VectorUtils::LimbKernels::portable, BigNumber::VectorUtils::LimbKernels::adc,
+                                BigNumber::VectorUtils::LimbKernels::adx }) {
+        if (kernels > supported) {
+            EXPECT_THROW(BigNumber::VectorUtils::set_limb_kernels(kernels), std::runtime_error);
+            continue;
+        }
+        BigNumber::VectorUtils::set_limb_kernels(kernels);
+        BigNumber::BigNumber a(std::string(300, '9').c_str(), 40 * 64);
+        const BigNumber::BigNumber copy = a;
+        BigNumber::BigNumber b = a * copy;
+        EXPECT_EQ(std::string(299, '9') + "8" + std::string(299, '0') + "1", b.to_string());
+        BigNumber::BigNumber c = b / a;
+        EXPECT_EQ(std::string(300, '9'), c.to_string());
+        BigNumber::BigNumber d = b - a;
+        EXPECT_EQ(std::string(299, '9') + "7" + std::string(299, '0') + "2", d.to_string());
+    }
+    BigNumber::VectorUtils::set_limb_kernels(supported);
 }
 
 // Comparison
@@ -269,12 +595,79 @@ TEST(BigNumberTest, Less) {
     EXPECT_FALSE(a < b);
 }
 
+TEST(BigNumberTest, CompareNegative) {
+    BigNumber::BigNumber a("-5", precision);
+    BigNumber::BigNumber b("-3", precision);
+    EXPECT_TRUE(a < b);
+    EXPECT_TRUE(b > a);
+}
+
+TEST(BigNumberTest, CompareMixedPrecision) {
+    BigNumber::BigNumber a("18446744073709551616.5", 4 * 64);
+    BigNumber::BigNumber b("18446744073709551616", 64);
+    BigNumber::BigNumber c("0.5", 64);
+    EXPECT_TRUE(a > b);
+    EXPECT_TRUE(b < a);
+    EXPECT_TRUE(a - c == b);
+    EXPECT_TRUE(c < a);
+    EXPECT_TRUE(-a < -c);
+}
+
 // Adapters
 TEST(BigNumberTest, ToString) {
     BigNumber::BigNumber a("1234567890123456789012345678901234567.8901234567890", precision);
     EXPECT_EQ("1234567890123456789012345678901234567.8901234567890", a.to_string());
 }
 
+TEST(BigNumberTest, LongToString) {
+    const std::string s = "1" + std::string(3000, '0');
+    BigNumber::BigNumber a(s.c_str(), 200 * 64);
+    EXPECT_EQ(s, a.to_string());
+}
+
+TEST(BigNumberTest, TinyToString) {
+    BigNumber::BigNumber a("1", precision);
+    a /= 9223372036854775808ull;
+    a /= 9223372036854775808ull;
+    a /= 9223372036854775808ull;
+    EXPECT_EQ("0.000000000000000000000000000000000000000000000000000000001274473528905961821623104318214169444472883644154095"
+              "028859108682708930321210446528754471899776146148752786757540889084339141845703125", a.to_string());
+}
+
+TEST(BigNumberTest, StreamDigits) {
+    const BigNumber::BigNumber a = BigNumber::BigNumber(static_cast<uint64_t>(1), 4096 * 64) / 7;
+    const std::string digits = a.to_string();
+    std::vector<std::string> blocks;
+    a.write([&blocks](std::string_view block) { blocks.emplace_back(block); });
+    EXPECT_LT(1, blocks.size());
+    std::string joined;
+    for (const std::string& block : blocks) {
+        EXPECT_GE(BigNumber::VectorUtils::DIGIT_BLOCK_SIZE, block.size());
+        joined += block;
+    }
+    EXPECT_EQ(digits, joined);
+
+    std::ostringstream stream;
+    stream << a;
+    EXPECT_EQ(digits, stream.str());
+    for (uint64_t limit : { 2, 10, 1000, 100000 }) {
+        std::ostringstream prefix;
+        a.write(prefix, limit);
+        EXPECT_EQ(digits.substr(0, limit + 1), prefix.str());
+    }
+
+    const BigNumber::BigNumber b("-123.456", precision);
+    std::ostringstream integer;
+    b.write(integer, 2);
+    EXPECT_EQ("-12", integer.str());
+    std::ostringstream fraction;
+    b.write(fraction, 5);
+    EXPECT_EQ("-123.45", fraction.str());
+    std::ostringstream tiny;
+    (BigNumber::BigNumber(static_cast<uint64_t>(1), precision) / 1000000000000000000ull).write(tiny, 20);
+    EXPECT_EQ("0.0000000000000000009", tiny.str());
+}
+
 // UD literals
 TEST(BigNumberTest, Uint16Literal) {
     BigNumber::BigNumber a = 123_b;
@@ -287,3 +680,211 @@ TEST(BigNumberTest, DoubleLiteral) {
 }
 
 
+
+// Fixed precision
+TEST(BigNumberTest, BigFixed) {
+    constexpr BigNumber::BigFixed<2> a = BigNumber::BigFixed<2>(6) * BigNumber::BigFixed<2>(7) / 4;
+    static_assert(a > BigNumber::BigFixed<2>(10) && a < BigNumber::BigFixed<2>(11));
+    static_assert(factorial(BigNumber::BigFixed<2>(20)) == BigNumber::BigFixed<2>(2432902008176640000ull));
+    EXPECT_EQ("10.5", a.to_string());
+
+    BigNumber::BigFixed<10> b("12345678901234567890123456789012345678901234567890");
+    EXPECT_EQ("152415787532388367504953515625666819450083828733757049236500533455762536198787501905199875019052100",
+              (b * b).to_string());
+    BigNumber::BigNumber c = static_cast<BigNumber::BigNumber>(b - BigNumber::BigFixed<10>(1) / 3);
+    BigNumber::BigNumber d = BigNumber::BigNumber(b) - BigNumber::BigNumber(1, precision) / 3;
+    EXPECT_EQ(d.to_string(), c.to_string());
+}
+
+// Batches
+TEST(BigNumberTest, BigNumberBatch) {
+    const BigNumber::VectorUtils::BatchKernels supported = BigNumber::VectorUtils::supported_batch_kernels();
+    for (const auto kernels : { BigNumber::VectorUtils::BatchKernels::portable,
+                                BigNumber::VectorUtils::BatchKernels::avx2,
+                                BigNumber::VectorUtils::BatchKernels::avx512 }) {
+        if (kernels > supported)
+            continue;
+        BigNumber::VectorUtils::set_batch_kernels(kernels);
+        BigNumber::BigNumberBatch prices(11, 128, 128);
+        BigNumber::BigNumberBatch fees(11, 128, 128);
+        for (size_t i = 0; i < prices.size(); ++i) {
+            prices.set(i, BigNumber::BigNumber(static_cast<double>(i) * 1.25 - 4.75, precision));
+            fees.set(i, BigNumber::BigNumber(0.5, precision));
+        }
+        prices.set(10, BigNumber::BigNumber("18446744073709551616.0078125", precision));
+        prices *= -3;
+        prices += fees;
+        prices -= fees;
+        prices -= fees;
+        EXPECT_EQ("13.75", prices.get(0).to_string());
+        EXPECT_EQ("-1.25", prices.get(4).to_string());
+        EXPECT_EQ("-20", prices.get(9).to_string());
+        EXPECT_EQ("-55340232221128654848.5234375", prices.get(10).to_string());
+        const std::vector<std::strong_ordering> order = prices.compare(fees);
+        EXPECT_EQ(std::strong_ordering::greater, order[0]);
+        EXPECT_EQ(std::strong_ordering::less, order[4]);
+        EXPECT_EQ(std::strong_ordering::less, order[10]);
+        prices.negate();
+        EXPECT_EQ("1.25", prices.get(4).to_string());
+        EXPECT_EQ(std::strong_ordering::greater, prices.compare(fees)[4]);
+        EXPECT_EQ(std::strong_ordering::equal, prices.compare(prices)[4]);
+
+        // The integer part holds 127 bits and the sign
+        BigNumber::BigNumberBatch small(2, 128, 0);
+        small.set(0, BigNumber::BigNumber("85070591730234615865843651857942052864", precision));
+        EXPECT_THROW(small *= 2, std::runtime_error);
+        EXPECT_THROW(small.set(1, BigNumber::BigNumber("170141183460469231731687303715884105728", precision)),
+                     std::runtime_error);
+        small.set(1, BigNumber::BigNumber("-170141183460469231731687303715884105728", precision));
+        EXPECT_THROW(small.negate(), std::runtime_error);
+        EXPECT_THROW(prices += small, std::runtime_error);
+    }
+    BigNumber::VectorUtils::set_batch_kernels(supported);
+}
+
+// Serialization
+TEST(BigNumberTest, Serialization) {
+    BigNumber::BigNumber a("-12345678901234567890.0625", precision);
+    std::vector<std::byte> buffer(BigNumber::serialized_size(a));
+    EXPECT_EQ(24 + 10 * 8, buffer.size());
+    EXPECT_EQ(buffer.size(), BigNumber::serialize(a, buffer));
+    BigNumber::BigNumber b(static_cast<uint64_t>(1), 64);
+    EXPECT_EQ(buffer.size(), BigNumber::deserialize(b, buffer));
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.to_string(), b.to_string());
+    EXPECT_EQ(BigNumber::serialized_size(a), BigNumber::serialized_size(b));
+
+    EXPECT_THROW(BigNumber::serialize(a, std::span(buffer).first(buffer.size() - 1)), std::runtime_error);
+    EXPECT_THROW(BigNumber::deserialize(b, std::span(buffer).first(buffer.size() - 8)), std::runtime_error);
+    buffer[0] = std::byte(2);
+    EXPECT_THROW(BigNumber::deserialize(b, buffer), std::runtime_error);
+
+    const std::vector<BigNumber::BigNumber> numbers = { a, BigNumber::BigNumber("0.5", 256 * 64),
+                                                        BigNumber::BigNumber(static_cast<uint64_t>(7), 64) };
+    std::vector<uint64_t> storage(BigNumber::serialized_array_size(numbers) / 8);
+    const std::span<std::byte> bytes = std::as_writable_bytes(std::span(storage));
+    EXPECT_EQ(bytes.size(), BigNumber::serialize_array(numbers, bytes));
+    const BigNumber::BigNumberArrayView view(bytes);
+    ASSERT_EQ(3, view.size());
+    EXPECT_EQ(256, view[1].limbs.size());
+    EXPECT_EQ(reinterpret_cast<const uint64_t *>(bytes.data()) + 3 + 3 + (3 + 10) + 3,
+              view[1].limbs.data());
+    EXPECT_EQ(a, view.get(0));
+    EXPECT_EQ("0.5", view.get(1).to_string());
+    EXPECT_THROW(static_cast<void>(view[3]), std::runtime_error);
+    EXPECT_THROW(BigNumber::BigNumberArrayView(bytes.subspan(8)), std::runtime_error);
+
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "big_number_test_array.bin";
+    std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char *>(bytes.data()),
+                                                static_cast<std::streamsize>(bytes.size()));
+    {
+        const BigNumber::MappedBigNumberArray mapped(path.string());
+        ASSERT_EQ(3, mapped.size());
+        EXPECT_EQ(7, mapped[2].limbs[0]);
+        EXPECT_EQ(numbers[1], mapped.get(1));
+    }
+    std::filesystem::remove(path);
+    EXPECT_THROW(BigNumber::MappedBigNumberArray(path.string()), std::runtime_error);
+}
+
+// Chunk storage
+TEST(BigNumberTest, ChunkVector) {
+    BigNumber::VectorUtils::ChunkVector a(BigNumber::VectorUtils::ChunkVector::INLINE_SIZE, 1);
+    EXPECT_TRUE(a.is_inline());
+    a.push_back(2);
+    EXPECT_FALSE(a.is_inline());
+    a.insert(a.begin(), a.begin() + 7, a.end());
+    EXPECT_EQ(11, a.size());
+    EXPECT_EQ(1, a.front());
+    EXPECT_EQ(2, a[1]);
+
+    BigNumber::VectorUtils::ChunkVector b = { 3, 4 };
+    BigNumber::VectorUtils::ChunkVector c = std::move(b);
+    EXPECT_TRUE(c.is_inline());
+    EXPECT_EQ(BigNumber::VectorUtils::ChunkVector({ 3, 4 }), c);
+}
+
+TEST(BigNumberTest, MemoryResource) {
+    BigNumber::VectorUtils::CountingResource counter;
+    BigNumber::VectorUtils::ChunkArena arena(1 << 12, &counter);
+    BigNumber::BigNumber a(0, 256 * 64);
+    {
+        BigNumber::VectorUtils::ScopedResource scope(&arena);
+        BigNumber::BigNumber b(3, 256 * 64);
+        BigNumber::BigNumber c = b / 7 * b;
+        BigNumber::VectorUtils::ScopedResource outside(std::pmr::get_default_resource());
+        a = c;
+    }
+    EXPECT_LT(0, arena.stats().allocations);
+    EXPECT_GT(arena.stats().allocations, counter.stats().allocations);
+    EXPECT_EQ(counter.stats().allocations, arena.upstream_stats().allocations);
+    arena.release();
+    EXPECT_EQ(counter.stats().allocations, counter.stats().deallocations);
+    EXPECT_EQ("1.28571428571428", a.to_string().substr(0, 16));
+
+    BigNumber::VectorUtils::ChunkPool pool;
+    {
+        BigNumber::VectorUtils::ScopedResource scope(&pool);
+        BigNumber::BigNumber d(5, 256 * 64);
+        for (int i = 0; i < 8; ++i)
+            d = d * d / 3;
+    }
+    EXPECT_LT(0, pool.stats().allocations);
+    EXPECT_EQ(pool.stats().allocations, pool.stats().deallocations);
+    EXPECT_EQ(0, pool.stats().bytes_in_use);
+}
+
+TEST(BigNumberTest, MemoryResourceCachedPowers) {
+    // A fresh thread starts with empty caches, so the conversion grows them inside the arena's scope
+    const BigNumber::BigNumber a = pow(BigNumber::BigNumber(3, 64 * 64), 2000);
+    std::string first;
+    std::string second;
+    std::thread([&] {
+        {
+            BigNumber::VectorUtils::ChunkArena arena;
+            {
+                BigNumber::VectorUtils::ScopedResource scope(&arena);
+                first = a.to_string();
+            }
+            arena.release();
+            second = a.to_string();
+        }
+        // Caches are destroyed at thread exit, after the arena
+    }).join();
+    EXPECT_EQ("17478712517226516096599746191646605705290624874351", first.substr(0, 50));
+    EXPECT_EQ(955, first.size());
+    EXPECT_EQ(first, second);
+}
+
+// Instrumentation
+TEST(BigNumberTest, Instrumentation) {
+    using BigNumber::VectorUtils::Kernel;
+    BigNumber::VectorUtils::reset_instrumentation();
+    BigNumber::BigNumber a("12345678901234567890.5", 64 * 64);
+    BigNumber::BigNumber b = a * a / 7;
+    EXPECT_FALSE(b.to_string().empty());
+    BigNumber::VectorUtils::InstrumentationSnapshot snapshot = BigNumber::VectorUtils::instrumentation_snapshot();
+    if (BigNumber::VectorUtils::INSTRUMENTATION_ENABLED) {
+        EXPECT_LT(0, snapshot[Kernel::to_integer_vector].calls);
+        EXPECT_LT(0, snapshot[Kernel::multiply_vectors].calls + snapshot[Kernel::square_vector].calls);
+        EXPECT_LT(0, snapshot[Kernel::normalise_mantissa].calls);
+        EXPECT_LT(0, snapshot[Kernel::to_integer_string].calls);
+        EXPECT_LT(0, snapshot.allocations.allocations);
+        // 64 chunks less the two integer ones
+        EXPECT_EQ(1, snapshot[Kernel::to_fraction_vector].sizes[5]);
+    } else {
+        EXPECT_EQ(0, snapshot[Kernel::multiply_vectors].calls);
+        EXPECT_EQ(0, snapshot.allocations.allocations);
+    }
+    BigNumber::VectorUtils::InstrumentationSnapshot total = snapshot;
+    total += snapshot;
+    EXPECT_EQ(2 * snapshot[Kernel::normalise_mantissa].calls, total[Kernel::normalise_mantissa].calls);
+    const std::string json = BigNumber::VectorUtils::to_json(snapshot);
+    EXPECT_EQ("{\"kernels\":{\"add_mantissa\":{\"calls\":", json.substr(0, 36));
+    EXPECT_NE(std::string::npos, json.find("\"allocations\":{\"allocations\":"));
+
+    BigNumber::VectorUtils::reset_instrumentation();
+    snapshot = BigNumber::VectorUtils::instrumentation_snapshot();
+    EXPECT_EQ(0, snapshot[Kernel::normalise_mantissa].calls);
+    EXPECT_EQ(0, snapshot[Kernel::normalise_mantissa].nanoseconds);
+}
@@ -0,0 +1,67 @@
+#include "batch_kernels_impl.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace BigNumber::VectorUtils {
+
+#ifdef __AVX2__
+    namespace {
+        struct Avx2Lanes {
+            using Vector = __m256i;
+            static constexpr size_t LANES = 4;
+
+            static Vector load(const uint64_t *source) {
+                return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(source));
+            }
+
+            static void store(uint64_t *destination, Vector value) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(destination), value);
+            }
+
+            static Vector set(uint64_t value) { return _mm256_set1_epi64x(static_cast<long long>(value)); }
+            static Vector zero() { return _mm256_setzero_si256(); }
+            static Vector add(Vector a, Vector b) { return _mm256_add_epi64(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm256_sub_epi64(a, b); }
+            static Vector bit_and(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+            static Vector bit_and_not(Vector a, Vector b) { return _mm256_andnot_si256(a, b); }
+            static Vector bit_or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+            static Vector bit_xor(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+            static Vector equal(Vector a, Vector b) { return _mm256_cmpeq_epi64(a, b); }
+            static Vector negative(Vector a) { return _mm256_cmpgt_epi64(zero(), a); }
+            static bool any(Vector a) { return _mm256_testz_si256(a, a) == 0; }
+
+            static Vector less(Vector a, Vector b) {
+                // AVX2 only compares signed
+                const Vector sign_bit = set(uint64_t(1) << 63);
+                return _mm256_cmpgt_epi64(_mm256_xor_si256(b, sign_bit), _mm256_xor_si256(a, sign_bit));
+            }
+
+            static Vector multiply(Vector a, Vector b, Vector& high) {
+                // Full 64 x 64 bit products from four 32 x 32 bit ones
+                const Vector low_half = set(0xffff'ffffull);
+                const Vector a_high = _mm256_srli_epi64(a, 32);
+                const Vector b_high = _mm256_srli_epi64(b, 32);
+                const Vector low_low = _mm256_mul_epu32(a, b);
+                const Vector low_high = _mm256_mul_epu32(a, b_high);
+                const Vector high_low = _mm256_mul_epu32(a_high, b);
+                const Vector high_high = _mm256_mul_epu32(a_high, b_high);
+                const Vector middle = add(add(_mm256_srli_epi64(low_low, 32), bit_and(low_high, low_half)),
+                                          bit_and(high_low, low_half));
+                high = add(add(high_high, _mm256_srli_epi64(low_high, 32)),
+                           add(_mm256_srli_epi64(high_low, 32), _mm256_srli_epi64(middle, 32)));
+                return bit_or(bit_and(low_low, low_half), _mm256_slli_epi64(middle, 32));
+            }
+        };
+    }
+
+    const BatchKernelTable *avx2_batch_kernel_table() {
+        return &BatchDetail::table<Avx2Lanes>;
+    }
+#else
+    const BatchKernelTable *avx2_batch_kernel_table() {
+        return nullptr;
+    }
+#endif
+}
@@ -0,0 +1,62 @@
+#include "batch_kernels_impl.h"
+
+#ifdef __AVX512F__
+#include <immintrin.h>
+#endif
+
+namespace BigNumber::VectorUtils {
+
+#ifdef __AVX512F__
+    namespace {
+        // AVX-512F only. IFMA multiplies 52 bit digits and does not fit 64 bit chunks,
+        // products are assembled from 32 bit halves as with AVX2
+        struct Avx512Lanes {
+            using Vector = __m512i;
+            static constexpr size_t LANES = 8;
+
+            static Vector load(const uint64_t *source) { return _mm512_loadu_si512(source); }
+            static void store(uint64_t *destination, Vector value) { _mm512_storeu_si512(destination, value); }
+            static Vector set(uint64_t value) { return _mm512_set1_epi64(static_cast<long long>(value)); }
+            static Vector zero() { return _mm512_setzero_si512(); }
+            static Vector add(Vector a, Vector b) { return _mm512_add_epi64(a, b); }
+            static Vector subtract(Vector a, Vector b) { return _mm512_sub_epi64(a, b); }
+            static Vector bit_and(Vector a, Vector b) { return _mm512_and_si512(a, b); }
+            static Vector bit_and_not(Vector a, Vector b) { return _mm512_andnot_si512(a, b); }
+            static Vector bit_or(Vector a, Vector b) { return _mm512_or_si512(a, b); }
+            static Vector bit_xor(Vector a, Vector b) { return _mm512_xor_si512(a, b); }
+            static Vector negative(Vector a) { return _mm512_srai_epi64(a, 63); }
+            static bool any(Vector a) { return _mm512_test_epi64_mask(a, a) != 0; }
+
+            static Vector mask(__mmask8 lanes) {
+                return _mm512_maskz_mov_epi64(lanes, set(~uint64_t(0)));
+            }
+
+            static Vector equal(Vector a, Vector b) { return mask(_mm512_cmpeq_epu64_mask(a, b)); }
+            static Vector less(Vector a, Vector b) { return mask(_mm512_cmplt_epu64_mask(a, b)); }
+
+            static Vector multiply(Vector a, Vector b, Vector& high) {
+                const Vector low_half = set(0xffff'ffffull);
+                const Vector a_high = _mm512_srli_epi64(a, 32);
+                const Vector b_high = _mm512_srli_epi64(b, 32);
+                const Vector low_low = _mm512_mul_epu32(a, b);
+                const Vector low_high = _mm512_mul_epu32(a, b_high);
+                const Vector high_low = _mm512_mul_epu32(a_high, b);
+                const Vector high_high = _mm512_mul_epu32(a_high, b_high);
+                const Vector middle = add(add(_mm512_srli_epi64(low_low, 32), bit_and(low_high, low_half)),
+                                          bit_and(high_low, low_half));
+                high = add(add(high_high, _mm512_srli_epi64(low_high, 32)),
+                           add(_mm512_srli_epi64(high_low, 32), _mm512_srli_epi64(middle, 32)));
+                return bit_or(bit_and(low_low, low_half), _mm512_slli_epi64(middle, 32));
+            }
+        };
+    }
+
+    const BatchKernelTable *avx512_batch_kernel_table() {
+        return &BatchDetail::table<Avx512Lanes>;
+    }
+#else
+    const BatchKernelTable *avx512_batch_kernel_table() {
+        return nullptr;
+    }
+#endif
+}
@@ -0,0 +1,111 @@
+#include "batch_kernels.h"
+#include "batch_kernels_impl.h"
+
+#include <atomic>
+#include <stdexcept>
+
+namespace BigNumber::VectorUtils {
+
+    namespace {
+        struct ScalarLanes {
+            using Vector = uint64_t;
+            static constexpr size_t LANES = 1;
+
+            static Vector load(const uint64_t *source) { return *source; }
+            static void store(uint64_t *destination, Vector value) { *destination = value; }
+            static Vector set(uint64_t value) { return value; }
+            static Vector zero() { return 0; }
+            static Vector add(Vector a, Vector b) { return a + b; }
+            static Vector subtract(Vector a, Vector b) { return a - b; }
+            static Vector bit_and(Vector a, Vector b) { return a & b; }
+            static Vector bit_and_not(Vector a, Vector b) { return ~a & b; }
+            static Vector bit_or(Vector a, Vector b) { return a | b; }
+            static Vector bit_xor(Vector a, Vector b) { return a ^ b; }
+            static Vector equal(Vector a, Vector b) { return a == b ? ~uint64_t(0) : 0; }
+            static Vector less(Vector a, Vector b) { return a < b ? ~uint64_t(0) : 0; }
+            static Vector negative(Vector a) { return 0 - (a >> 63); }
+            static bool any(Vector a) { return a != 0; }
+
+            static Vector multiply(Vector a, Vector b, Vector& high) {
+                const __uint128_t product = static_cast<__uint128_t>(a) * b;
+                high = static_cast<uint64_t>(product >> 64);
+                return static_cast<uint64_t>(product);
+            }
+        };
+
+        const BatchKernelTable& kernel_table(BatchKernels kernels) {
+            if (kernels == BatchKernels::avx512)
+                return *avx512_batch_kernel_table();
+            if (kernels == BatchKernels::avx2)
+                return *avx2_batch_kernel_table();
+            return BatchDetail::table<ScalarLanes>;
+        }
+
+        BatchKernels detect_batch_kernels() {
+            // Kernels need both the build (the instruction set translation unit) and the CPU to support them
+#if defined(__x86_64__) && defined(__GNUC__)
+            __builtin_cpu_init();
+            if (avx512_batch_kernel_table() != nullptr && __builtin_cpu_supports("avx512f"))
+                return BatchKernels::avx512;
+            if (avx2_batch_kernel_table() != nullptr && __builtin_cpu_supports("avx2"))
+                return BatchKernels::avx2;
+#endif
+            return BatchKernels::portable;
+        }
+
+        struct Selection {
+            BatchKernels supported = detect_batch_kernels();
+            std::atomic<BatchKernels> kernels = supported;
+            std::atomic<const BatchKernelTable *> table = &kernel_table(supported);
+        };
+
+        Selection& selection() {
+            static Selection instance;
+            return instance;
+        }
+
+        const BatchKernelTable& kernels() {
+            return *selection().table.load(std::memory_order_relaxed);
+        }
+    }
+
+    BatchKernels supported_batch_kernels() {
+        return selection().supported;
+    }
+
+    BatchKernels batch_kernels() {
+        return selection().kernels.load(std::memory_order_relaxed);
+    }
+
+    void set_batch_kernels(BatchKernels kernels) {
+        // AVX-512 support does not imply an AVX2 build, check the table itself
+        const bool available = kernels == BatchKernels::portable
+                               || (static_cast<int>(kernels) <= static_cast<int>(supported_batch_kernels())
+                                   && (kernels == BatchKernels::avx2 ? avx2_batch_kernel_table()
+                                                                     : avx512_batch_kernel_table()) != nullptr);
+        if (!available)
+            throw std::runtime_error("Batch kernels are not supported by this CPU");
+        selection().kernels.store(kernels, std::memory_order_relaxed);
+        selection().table.store(&kernel_table(kernels), std::memory_order_relaxed);
+    }
+
+    bool add_batch(uint64_t *self, const uint64_t *other, size_t stride, size_t chunks) {
+        return kernels().add(self, other, stride, chunks);
+    }
+
+    bool subtract_batch(uint64_t *self, const uint64_t *other, size_t stride, size_t chunks) {
+        return kernels().subtract(self, other, stride, chunks);
+    }
+
+    bool multiply_batch(uint64_t *self, uint64_t number, size_t stride, size_t chunks) {
+        return kernels().multiply(self, number, stride, chunks);
+    }
+
+    bool negate_batch(uint64_t *self, size_t stride, size_t chunks) {
+        return kernels().negate(self, stride, chunks);
+    }
+
+    void compare_batch(const uint64_t *lhs, const uint64_t *rhs, int8_t *result, size_t stride, size_t chunks) {
+        kernels().compare(lhs, rhs, result, stride, chunks);
+    }
+}
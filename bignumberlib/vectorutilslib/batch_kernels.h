@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace BigNumber::VectorUtils {
+
+    // Kernel sets for the batch loops below, selected by CPUID at startup
+    enum class BatchKernels {
+        portable,
+        avx2,
+        avx512
+    };
+
+    BatchKernels supported_batch_kernels();
+    BatchKernels batch_kernels();
+    // Throws for a set the CPU does not support. Must not be changed while work is running
+    void set_batch_kernels(BatchKernels);
+
+    // Elements processed at once by the widest kernels, batch strides are multiples of it
+    const size_t BATCH_LANES = 8;
+
+    // Element-wise loops over a structure of arrays: chunk j of element i is data[j * stride + i] and elements are
+    // two's complement numbers of chunks chunks. All stride elements are processed. Return whether any element
+    // overflowed, the results then wrap around
+
+    bool add_batch(uint64_t *self, const uint64_t *other, size_t stride, size_t chunks);
+    bool subtract_batch(uint64_t *self, const uint64_t *other, size_t stride, size_t chunks);
+    bool multiply_batch(uint64_t *self, uint64_t number, size_t stride, size_t chunks);
+    bool negate_batch(uint64_t *self, size_t stride, size_t chunks);
+    // Writes -1, 0 or 1 for each element
+    void compare_batch(const uint64_t *lhs, const uint64_t *rhs, int8_t *result, size_t stride, size_t chunks);
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+// Generic batch kernels, instantiated once per lane type. Included by the translation units that are compiled for
+// a specific instruction set, so it must only pull in headers without inline functions of their own
+
+#include <cstddef>
+#include <cstdint>
+
+namespace BigNumber::VectorUtils {
+
+    struct BatchKernelTable {
+        bool (*add)(uint64_t *, const uint64_t *, size_t, size_t);
+        bool (*subtract)(uint64_t *, const uint64_t *, size_t, size_t);
+        bool (*multiply)(uint64_t *, uint64_t, size_t, size_t);
+        bool (*negate)(uint64_t *, size_t, size_t);
+        void (*compare)(const uint64_t *, const uint64_t *, int8_t *, size_t, size_t);
+    };
+
+    // Tables of the instruction set specific translation units, null when they are built without it
+    const BatchKernelTable *avx2_batch_kernel_table();
+    const BatchKernelTable *avx512_batch_kernel_table();
+
+    namespace BatchDetail {
+        // Lanes provides a Vector of LANES chunks with loads, stores, bitwise and wrapping arithmetic operations.
+        // Comparisons return masks of all ones or zero, so a mask subtracted adds one
+
+        template <typename Lanes>
+        bool add(uint64_t *self, const uint64_t *other, size_t stride, size_t chunks) {
+            using Vector = typename Lanes::Vector;
+            Vector overflow = Lanes::zero();
+            for (size_t i = 0; i < stride; i += Lanes::LANES) {
+                Vector carry = Lanes::zero();
+                Vector a = carry, b = carry, sum = carry;
+                for (size_t j = 0; j < chunks; ++j) {
+                    a = Lanes::load(self + j * stride + i);
+                    b = Lanes::load(other + j * stride + i);
+                    sum = Lanes::add(a, b);
+                    const Vector carry_out = Lanes::less(sum, a);
+                    sum = Lanes::subtract(sum, carry);
+                    carry = Lanes::bit_or(carry_out, Lanes::bit_and(carry, Lanes::equal(sum, Lanes::zero())));
+                    Lanes::store(self + j * stride + i, sum);
+                }
+                // Operands of the same sign with a sum of the other sign
+                overflow = Lanes::bit_or(overflow, Lanes::bit_and(Lanes::bit_xor(a, sum), Lanes::bit_xor(b, sum)));
+            }
+            return Lanes::any(Lanes::negative(overflow));
+        }
+
+        template <typename Lanes>
+        bool subtract(uint64_t *self, const uint64_t *other, size_t stride, size_t chunks) {
+            using Vector = typename Lanes::Vector;
+            Vector overflow = Lanes::zero();
+            for (size_t i = 0; i < stride; i += Lanes::LANES) {
+                Vector borrow = Lanes::zero();
+                Vector a = borrow, b = borrow, difference = borrow;
+                for (size_t j = 0; j < chunks; ++j) {
+                    a = Lanes::load(self + j * stride + i);
+                    b = Lanes::load(other + j * stride + i);
+                    difference = Lanes::subtract(a, b);
+                    const Vector borrow_out = Lanes::less(a, b);
+                    const Vector borrow_in = Lanes::bit_and(borrow, Lanes::equal(difference, Lanes::zero()));
+                    difference = Lanes::add(difference, borrow);
+                    borrow = Lanes::bit_or(borrow_out, borrow_in);
+                    Lanes::store(self + j * stride + i, difference);
+                }
+                // Operands of different signs with a difference of the subtrahend's sign
+                overflow = Lanes::bit_or(overflow, Lanes::bit_and(Lanes::bit_xor(a, b),
+                                                                  Lanes::bit_xor(a, difference)));
+            }
+            return Lanes::any(Lanes::negative(overflow));
+        }
+
+        template <typename Lanes>
+        bool multiply(uint64_t *self, uint64_t number, size_t stride, size_t chunks) {
+            using Vector = typename Lanes::Vector;
+            const Vector multiplier = Lanes::set(number);
+            Vector overflow = Lanes::zero();
+            for (size_t i = 0; i < stride; i += Lanes::LANES) {
+                Vector high = Lanes::zero();
+                Vector a = high, product = high;
+                for (size_t j = 0; j < chunks; ++j) {
+                    a = Lanes::load(self + j * stride + i);
+                    Vector product_high;
+                    const Vector low = Lanes::multiply(a, multiplier, product_high);
+                    product = Lanes::add(low, high);
+                    high = Lanes::subtract(product_high, Lanes::less(product, low));
+                    Lanes::store(self + j * stride + i, product);
+                }
+                // The chunk above a negative element's product is the unsigned one minus number,
+                // it must extend the sign of the result
+                const Vector signed_high = Lanes::subtract(high, Lanes::bit_and(Lanes::negative(a), multiplier));
+                overflow = Lanes::bit_or(overflow, Lanes::bit_xor(signed_high, Lanes::negative(product)));
+            }
+            return Lanes::any(overflow);
+        }
+
+        template <typename Lanes>
+        bool negate(uint64_t *self, size_t stride, size_t chunks) {
+            using Vector = typename Lanes::Vector;
+            const Vector ones = Lanes::set(~uint64_t(0));
+            Vector overflow = Lanes::zero();
+            for (size_t i = 0; i < stride; i += Lanes::LANES) {
+                // ~a + 1
+                Vector carry = ones;
+                Vector a = Lanes::zero(), result = a;
+                for (size_t j = 0; j < chunks; ++j) {
+                    a = Lanes::load(self + j * stride + i);
+                    result = Lanes::subtract(Lanes::bit_xor(a, ones), carry);
+                    carry = Lanes::bit_and(carry, Lanes::equal(result, Lanes::zero()));
+                    Lanes::store(self + j * stride + i, result);
+                }
+                // Only the most negative number stays negative
+                overflow = Lanes::bit_or(overflow, Lanes::bit_and(a, result));
+            }
+            return Lanes::any(Lanes::negative(overflow));
+        }
+
+        template <typename Lanes>
+        void compare(const uint64_t *lhs, const uint64_t *rhs, int8_t *result, size_t stride, size_t chunks) {
+            using Vector = typename Lanes::Vector;
+            // The top chunk compares signed, flipping its sign bit turns that into an unsigned comparison
+            const Vector sign_bit = Lanes::set(uint64_t(1) << 63);
+            for (size_t i = 0; i < stride; i += Lanes::LANES) {
+                Vector less = Lanes::zero(), greater = less, decided = less;
+                for (size_t j = chunks; j-- > 0;) {
+                    Vector a = Lanes::load(lhs + j * stride + i);
+                    Vector b = Lanes::load(rhs + j * stride + i);
+                    if (j == chunks - 1) {
+                        a = Lanes::bit_xor(a, sign_bit);
+                        b = Lanes::bit_xor(b, sign_bit);
+                    }
+                    const Vector chunk_less = Lanes::less(a, b);
+                    const Vector chunk_greater = Lanes::less(b, a);
+                    less = Lanes::bit_or(less, Lanes::bit_and_not(decided, chunk_less));
+                    greater = Lanes::bit_or(greater, Lanes::bit_and_not(decided, chunk_greater));
+                    decided = Lanes::bit_or(decided, Lanes::bit_or(chunk_less, chunk_greater));
+                }
+                uint64_t less_lanes[Lanes::LANES];
+                uint64_t greater_lanes[Lanes::LANES];
+                Lanes::store(less_lanes, less);
+                Lanes::store(greater_lanes, greater);
+                for (size_t k = 0; k < Lanes::LANES; ++k)
+                    result[i + k] = static_cast<int8_t>((greater_lanes[k] & 1) - (less_lanes[k] & 1));
+            }
+        }
+
+        template <typename Lanes>
+        constexpr BatchKernelTable table = { add<Lanes>, subtract<Lanes>, multiply<Lanes>, negate<Lanes>,
+                                             compare<Lanes> };
+    }
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+
+#include "instrumentation.h"
+#include "memory.h"
+
+namespace BigNumber::VectorUtils {
+
+    // Vector of chunks that keeps up to INLINE_SIZE chunks inside the object and moves to the heap beyond that,
+    // so numbers of default and other small precisions never allocate. Heap chunks come from the resource current
+    // when the vector first leaves inline storage and stay with it on moves
+    class ChunkVector {
+     public:
+        static constexpr size_t INLINE_SIZE = 8;
+
+        using value_type = uint64_t;
+        using size_type = size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = uint64_t&;
+        using const_reference = const uint64_t&;
+        using pointer = uint64_t *;
+        using const_pointer = const uint64_t *;
+        using iterator = uint64_t *;
+        using const_iterator = const uint64_t *;
+
+        ChunkVector() noexcept : chunks(buffer), length(0), reserved(INLINE_SIZE), resource(nullptr) {}
+
+        explicit ChunkVector(size_t count) : ChunkVector() {
+            resize(count, 0);
+        }
+
+        ChunkVector(size_t count, uint64_t value) : ChunkVector() {
+            resize(count, value);
+        }
+
+        ChunkVector(std::initializer_list<uint64_t> init) : ChunkVector() {
+            assign(init.begin(), init.end());
+        }
+
+        template <std::forward_iterator It>
+        ChunkVector(It first, It last) : ChunkVector() {
+            assign(first, last);
+        }
+
+        ChunkVector(const ChunkVector& other) : ChunkVector() {
+            assign(other.begin(), other.end());
+        }
+
+        ChunkVector(ChunkVector&& other) noexcept : ChunkVector() {
+            steal(other);
+        }
+
+        ~ChunkVector() {
+            release();
+        }
+
+        ChunkVector& operator=(const ChunkVector& other) {
+            if (this != &other)
+                assign(other.begin(), other.end());
+            return *this;
+        }
+
+        ChunkVector& operator=(ChunkVector&& other) noexcept {
+            if (this != &other) {
+                release();
+                chunks = buffer;
+                length = 0;
+                reserved = INLINE_SIZE;
+                steal(other);
+            }
+            return *this;
+        }
+
+        ChunkVector& operator=(std::initializer_list<uint64_t> init) {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        // Size and capacity
+        [[nodiscard]] size_t size() const noexcept { return length; }
+        [[nodiscard]] bool empty() const noexcept { return length == 0; }
+        [[nodiscard]] size_t capacity() const noexcept { return reserved; }
+        [[nodiscard]] bool is_inline() const noexcept { return chunks == buffer; }
+        // Resource of heap chunks, nullptr while inline
+        [[nodiscard]] std::pmr::memory_resource *get_resource() const noexcept { return is_inline() ? nullptr : resource; }
+
+        void reserve(size_t count) {
+            if (count > reserved)
+                reallocate(count);
+        }
+
+        void resize(size_t count, uint64_t value = 0) {
+            if (count > reserved)
+                reallocate(std::max(count, reserved * 2));
+            if (count > length)
+                std::fill(chunks + length, chunks + count, value);
+            length = count;
+        }
+
+        void clear() noexcept { length = 0; }
+
+        // Element access
+        [[nodiscard]] uint64_t *data() noexcept { return chunks; }
+        [[nodiscard]] const uint64_t *data() const noexcept { return chunks; }
+        uint64_t& operator[](size_t index) noexcept { return chunks[index]; }
+        const uint64_t& operator[](size_t index) const noexcept { return chunks[index]; }
+        uint64_t& front() noexcept { return chunks[0]; }
+        const uint64_t& front() const noexcept { return chunks[0]; }
+        uint64_t& back() noexcept { return chunks[length - 1]; }
+        const uint64_t& back() const noexcept { return chunks[length - 1]; }
+
+        // Iterators
+        iterator begin() noexcept { return chunks; }
+        iterator end() noexcept { return chunks + length; }
+        const_iterator begin() const noexcept { return chunks; }
+        const_iterator end() const noexcept { return chunks + length; }
+        const_iterator cbegin() const noexcept { return chunks; }
+        const_iterator cend() const noexcept { return chunks + length; }
+
+        // Modifiers
+        void push_back(uint64_t value) {
+            if (length == reserved)
+                reallocate(reserved * 2);
+            chunks[length++] = value;
+        }
+
+        void pop_back() noexcept { --length; }
+
+        iterator insert(const_iterator position, uint64_t value) {
+            return insert(position, 1, value);
+        }
+
+        iterator insert(const_iterator position, size_t count, uint64_t value) {
+            const size_t index = position - chunks;
+            const iterator gap = open_gap(index, count);
+            std::fill(gap, gap + count, value);
+            return gap;
+        }
+
+        template <std::forward_iterator It>
+        iterator insert(const_iterator position, It first, It last) {
+            if constexpr (std::is_convertible_v<It, const_iterator>) {
+                // A range of this vector is copied aside, opening the gap may move it
+                const_iterator source = first;
+                if (source >= chunks && source < chunks + length) {
+                    const ChunkVector copy(first, last);
+                    return insert(position, copy.begin(), copy.end());
+                }
+            }
+            const size_t index = position - chunks;
+            const size_t count = std::distance(first, last);
+            const iterator gap = open_gap(index, count);
+            std::copy(first, last, gap);
+            return gap;
+        }
+
+        iterator erase(const_iterator position) {
+            return erase(position, position + 1);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            const size_t index = first - chunks;
+            const size_t count = last - first;
+            std::move(chunks + index + count, chunks + length, chunks + index);
+            length -= count;
+            return chunks + index;
+        }
+
+        friend bool operator==(const ChunkVector& lhs, const ChunkVector& rhs) {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+     private:
+        uint64_t *chunks;
+        size_t length;
+        size_t reserved;
+        std::pmr::memory_resource *resource;
+        uint64_t buffer[INLINE_SIZE];
+
+        void reallocate(size_t count) {
+            if (chunks == buffer)
+                resource = current_resource();
+            auto *heap = static_cast<uint64_t *>(resource->allocate(count * sizeof(uint64_t), alignof(uint64_t)));
+            BIGNUMBER_RECORD_ALLOCATION(count * sizeof(uint64_t));
+            std::copy(chunks, chunks + length, heap);
+            release();
+            chunks = heap;
+            reserved = count;
+        }
+
+        template <std::forward_iterator It>
+        void assign(It first, It last) {
+            // Replaces the contents by a range from elsewhere, chunks are written before they are ever read
+            const size_t count = std::distance(first, last);
+            length = 0;
+            reserve(count);
+            std::copy(first, last, chunks);
+            length = count;
+        }
+
+        void release() noexcept {
+            if (chunks != buffer) {
+                resource->deallocate(chunks, reserved * sizeof(uint64_t), alignof(uint64_t));
+                BIGNUMBER_RECORD_DEALLOCATION(reserved * sizeof(uint64_t));
+            }
+        }
+
+        void steal(ChunkVector& other) noexcept {
+            // this is empty and inline
+            if (other.chunks != other.buffer) {
+                chunks = other.chunks;
+                reserved = other.reserved;
+                resource = other.resource;
+            } else {
+                std::copy(other.buffer, other.buffer + other.length, buffer);
+            }
+            length = other.length;
+            other.chunks = other.buffer;
+            other.length = 0;
+            other.reserved = INLINE_SIZE;
+        }
+
+        iterator open_gap(size_t index, size_t count) {
+            if (length + count > reserved)
+                reallocate(std::max(length + count, reserved * 2));
+            std::move_backward(chunks + index, chunks + length, chunks + length + count);
+            length += count;
+            return chunks + index;
+        }
+    };
+
+    // Sign and magnitude of an integer, the magnitude trimmed and zero never negative
+    struct SignedVector {
+        ChunkVector magnitude;
+        bool negative;
+    };
+}
@@ -0,0 +1,73 @@
+#include "digit_writer.h"
+
+#include <algorithm>
+
+namespace BigNumber::VectorUtils {
+
+    DigitWriter::DigitWriter(DigitSink sink, uint64_t limit)
+        : sink(std::move(sink)), limit(limit), skipped(0), leading_zeros(false) {}
+
+    void DigitWriter::write_symbol(char symbol) {
+        buffer.push_back(symbol);
+        if (buffer.size() >= DIGIT_BLOCK_SIZE)
+            flush();
+    }
+
+    void DigitWriter::write_digits(std::string_view digits) {
+        const uint64_t dropped = std::min<uint64_t>(skipped, digits.size());
+        digits.remove_prefix(dropped);
+        skipped -= dropped;
+        if (leading_zeros) {
+            const uint64_t first = digits.find_first_not_of('0');
+            if (first == std::string_view::npos)
+                return;
+            digits.remove_prefix(first);
+            leading_zeros = false;
+        }
+        digits = digits.substr(0, limit);
+        limit -= digits.size();
+        while (!digits.empty()) {
+            const uint64_t length = std::min<uint64_t>(digits.size(), DIGIT_BLOCK_SIZE - buffer.size());
+            buffer.append(digits.substr(0, length));
+            digits.remove_prefix(length);
+            if (buffer.size() >= DIGIT_BLOCK_SIZE)
+                flush();
+        }
+    }
+
+    void DigitWriter::write_zeros(uint64_t count) {
+        const uint64_t dropped = std::min(skipped, count);
+        skipped -= dropped;
+        count -= dropped;
+        if (leading_zeros)
+            return;
+        count = std::min(count, limit);
+        limit -= count;
+        while (count > 0) {
+            const uint64_t length = std::min(count, DIGIT_BLOCK_SIZE - buffer.size());
+            buffer.append(length, '0');
+            count -= length;
+            if (buffer.size() >= DIGIT_BLOCK_SIZE)
+                flush();
+        }
+    }
+
+    void DigitWriter::skip(uint64_t count) {
+        skipped += count;
+    }
+
+    void DigitWriter::skip_leading_zeros() {
+        leading_zeros = true;
+    }
+
+    uint64_t DigitWriter::remaining() const {
+        return limit;
+    }
+
+    void DigitWriter::flush() {
+        if (buffer.empty())
+            return;
+        sink(buffer);
+        buffer.clear();
+    }
+}
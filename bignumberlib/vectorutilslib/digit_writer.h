@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace BigNumber::VectorUtils {
+
+    // Receives consecutive blocks of a number's characters, most significant digits first
+    using DigitSink = std::function<void(std::string_view)>;
+
+    // Characters buffered before they are passed on to a sink
+    const uint64_t DIGIT_BLOCK_SIZE = 1 << 16;
+    const uint64_t UNLIMITED_DIGITS = ~uint64_t(0);
+
+    // Buffers characters for a sink and drops the digits past its limit, symbols (sign, point) do not count.
+    // Blocks are passed on when the buffer is full and on flush
+    class DigitWriter {
+     public:
+        explicit DigitWriter(DigitSink, uint64_t = UNLIMITED_DIGITS);
+
+        void write_symbol(char);
+        void write_digits(std::string_view);
+        void write_zeros(uint64_t);
+        // Drops the next digits, or the zeros before the next other digit
+        void skip(uint64_t);
+        void skip_leading_zeros();
+        [[nodiscard]] uint64_t remaining() const;
+        void flush();
+
+     private:
+        DigitSink sink;
+        std::string buffer;
+        uint64_t limit;
+        uint64_t skipped;
+        bool leading_zeros;
+    };
+}
@@ -0,0 +1,102 @@
+#include "instrumentation.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace BigNumber::VectorUtils {
+
+    namespace {
+        thread_local InstrumentationSnapshot counters;
+
+        const char *const KERNEL_NAMES[KERNEL_COUNT] = {
+            "add_mantissa", "subtract_mantissa", "multiply_vectors", "square_vector", "multiply_ntt",
+            "divide_vectors", "modulo_vector", "reciprocal_vector", "sqrt_vector", "rsqrt_vector", "exp_vector",
+            "sin_cos_vector", "agm_vector", "normalise_mantissa", "to_integer_string", "to_fraction_string",
+            "to_integer_vector", "to_fraction_vector"
+        };
+
+        size_t size_bucket(size_t size) {
+            return std::min<size_t>(std::bit_width(std::max<size_t>(size, 1)) - 1, SIZE_BUCKETS - 1);
+        }
+    }
+
+    const char *kernel_name(Kernel kernel) {
+        return KERNEL_NAMES[static_cast<size_t>(kernel)];
+    }
+
+    const KernelStats& InstrumentationSnapshot::operator[](Kernel kernel) const {
+        return kernels[static_cast<size_t>(kernel)];
+    }
+
+    InstrumentationSnapshot& InstrumentationSnapshot::operator+=(const InstrumentationSnapshot& other) {
+        for (size_t i = 0; i < KERNEL_COUNT; ++i) {
+            kernels[i].calls += other.kernels[i].calls;
+            kernels[i].nanoseconds += other.kernels[i].nanoseconds;
+            for (size_t k = 0; k < SIZE_BUCKETS; ++k)
+                kernels[i].sizes[k] += other.kernels[i].sizes[k];
+        }
+        allocations.allocations += other.allocations.allocations;
+        allocations.deallocations += other.allocations.deallocations;
+        allocations.bytes_in_use += other.allocations.bytes_in_use;
+        allocations.peak_bytes += other.allocations.peak_bytes;
+        return *this;
+    }
+
+    InstrumentationSnapshot instrumentation_snapshot() {
+        return counters;
+    }
+
+    void reset_instrumentation() {
+        counters = InstrumentationSnapshot();
+    }
+
+    std::string to_json(const InstrumentationSnapshot& snapshot) {
+        // {"kernels":{"name":{"calls":n,"nanoseconds":n,"sizes":{"lower bound":n,...}},...},"allocations":{...}}
+        std::string result = "{\"kernels\":{";
+        for (size_t i = 0; i < KERNEL_COUNT; ++i) {
+            const KernelStats& stats = snapshot.kernels[i];
+            if (i > 0)
+                result += ',';
+            result += '"';
+            result += KERNEL_NAMES[i];
+            result += "\":{\"calls\":" + std::to_string(stats.calls);
+            result += ",\"nanoseconds\":" + std::to_string(stats.nanoseconds);
+            result += ",\"sizes\":{";
+            bool first = true;
+            for (size_t k = 0; k < SIZE_BUCKETS; ++k) {
+                if (stats.sizes[k] == 0)
+                    continue;
+                if (!first)
+                    result += ',';
+                first = false;
+                result += '"' + std::to_string(uint64_t(1) << k) + "\":" + std::to_string(stats.sizes[k]);
+            }
+            result += "}}";
+        }
+        const AllocationStats& allocations = snapshot.allocations;
+        result += "},\"allocations\":{\"allocations\":" + std::to_string(allocations.allocations);
+        result += ",\"deallocations\":" + std::to_string(allocations.deallocations);
+        result += ",\"bytes_in_use\":" + std::to_string(allocations.bytes_in_use);
+        result += ",\"peak_bytes\":" + std::to_string(allocations.peak_bytes);
+        result += "}}";
+        return result;
+    }
+
+    void record_kernel(Kernel kernel, size_t size, uint64_t nanoseconds) {
+        KernelStats& stats = counters.kernels[static_cast<size_t>(kernel)];
+        ++stats.calls;
+        stats.nanoseconds += nanoseconds;
+        ++stats.sizes[size_bucket(size)];
+    }
+
+    void record_allocation(size_t bytes) {
+        counters.allocations.allocated(bytes);
+    }
+
+    void record_deallocation(size_t bytes) {
+        // Chunks allocated before a reset or on another thread were never counted in here
+        AllocationStats& allocations = counters.allocations;
+        ++allocations.deallocations;
+        allocations.bytes_in_use -= std::min<uint64_t>(bytes, allocations.bytes_in_use);
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "memory.h"
+
+// Kernel counters are compiled in only with BIGNUMBER_INSTRUMENTATION defined (CMake option of the same name).
+// Without it the macros below expand to nothing and snapshots stay zero
+
+namespace BigNumber::VectorUtils {
+
+#ifdef BIGNUMBER_INSTRUMENTATION
+    const bool INSTRUMENTATION_ENABLED = true;
+#else
+    const bool INSTRUMENTATION_ENABLED = false;
+#endif
+
+    enum class Kernel {
+        add_mantissa,
+        subtract_mantissa,
+        multiply_vectors,
+        square_vector,
+        multiply_ntt,
+        divide_vectors,
+        modulo_vector,
+        reciprocal_vector,
+        sqrt_vector,
+        rsqrt_vector,
+        exp_vector,
+        sin_cos_vector,
+        agm_vector,
+        normalise_mantissa,
+        to_integer_string,
+        to_fraction_string,
+        to_integer_vector,
+        to_fraction_vector
+    };
+
+    const size_t KERNEL_COUNT = static_cast<size_t>(Kernel::to_fraction_vector) + 1;
+    // Bucket k counts calls on operands of [2^k, 2^(k + 1)) chunks, the last one everything above
+    const size_t SIZE_BUCKETS = 32;
+
+    const char *kernel_name(Kernel);
+
+    struct KernelStats {
+        uint64_t calls = 0;
+        // Includes nested kernels, multiply_vectors time contains its multiply_ntt calls
+        uint64_t nanoseconds = 0;
+        std::array<uint64_t, SIZE_BUCKETS> sizes{};
+    };
+
+    struct InstrumentationSnapshot {
+        std::array<KernelStats, KERNEL_COUNT> kernels{};
+        // Heap chunks of ChunkVector, inline storage never allocates
+        AllocationStats allocations;
+
+        [[nodiscard]] const KernelStats& operator[](Kernel) const;
+        // Sums snapshots of several threads, peak bytes add up to an upper bound
+        InstrumentationSnapshot& operator+=(const InstrumentationSnapshot&);
+    };
+
+    // Counters are per thread, work forked to the scheduler's workers is counted on the workers
+    InstrumentationSnapshot instrumentation_snapshot();
+    void reset_instrumentation();
+    std::string to_json(const InstrumentationSnapshot&);
+
+    void record_kernel(Kernel, size_t, uint64_t);
+    void record_allocation(size_t);
+    void record_deallocation(size_t);
+
+    // Records one call of a kernel on size chunks and its time until the scope ends
+    class KernelTimer {
+     public:
+        KernelTimer(Kernel kernel, size_t size) : kernel(kernel), size(size), start(std::chrono::steady_clock::now()) {}
+        ~KernelTimer() {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            record_kernel(kernel, size, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+        KernelTimer(const KernelTimer&) = delete;
+        KernelTimer& operator=(const KernelTimer&) = delete;
+
+     private:
+        Kernel kernel;
+        size_t size;
+        std::chrono::steady_clock::time_point start;
+    };
+}
+
+#ifdef BIGNUMBER_INSTRUMENTATION
+#define BIGNUMBER_INSTRUMENT(kernel, size) \
+    const ::BigNumber::VectorUtils::KernelTimer bignumber_kernel_timer(::BigNumber::VectorUtils::Kernel::kernel, size)
+#define BIGNUMBER_RECORD_ALLOCATION(bytes) ::BigNumber::VectorUtils::record_allocation(bytes)
+#define BIGNUMBER_RECORD_DEALLOCATION(bytes) ::BigNumber::VectorUtils::record_deallocation(bytes)
+#else
+#define BIGNUMBER_INSTRUMENT(kernel, size) static_cast<void>(0)
+#define BIGNUMBER_RECORD_ALLOCATION(bytes) static_cast<void>(0)
+#define BIGNUMBER_RECORD_DEALLOCATION(bytes) static_cast<void>(0)
+#endif
@@ -0,0 +1,334 @@
+#include "limb_kernels.h"
+
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#define BIGNUMBER_X86_64_KERNELS
+#endif
+
+namespace BigNumber::VectorUtils {
+
+    namespace {
+        // Portable loops, also used for the chunks in front of the unrolled x86-64 blocks
+
+        uint64_t add_portable(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count,
+                              uint64_t carry) {
+            for (size_t i = 0; i < count; ++i) {
+                const __uint128_t sum = static_cast<__uint128_t>(lhs[i]) + rhs[i] + carry;
+                result[i] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            return carry;
+        }
+
+        uint64_t subtract_portable(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count,
+                                   uint64_t borrow) {
+            for (size_t i = 0; i < count; ++i) {
+                const __uint128_t difference = static_cast<__uint128_t>(lhs[i]) - rhs[i] - borrow;
+                result[i] = static_cast<uint64_t>(difference);
+                borrow = static_cast<uint64_t>(difference >> 64) & 1;
+            }
+            return borrow;
+        }
+
+        uint64_t add_multiplied_portable(uint64_t *self, const uint64_t *other, size_t count, uint64_t number,
+                                         uint64_t carry) {
+            for (size_t i = 0; i < count; ++i) {
+                const __uint128_t product = static_cast<__uint128_t>(other[i]) * number + self[i] + carry;
+                self[i] = static_cast<uint64_t>(product);
+                carry = static_cast<uint64_t>(product >> 64);
+            }
+            return carry;
+        }
+
+        uint64_t subtract_multiplied_portable(uint64_t *self, const uint64_t *other, size_t count, uint64_t number,
+                                              uint64_t borrow) {
+            for (size_t i = 0; i < count; ++i) {
+                const __uint128_t product = static_cast<__uint128_t>(other[i]) * number + borrow;
+                const uint64_t low = static_cast<uint64_t>(product);
+                borrow = static_cast<uint64_t>(product >> 64) + (self[i] < low);
+                self[i] -= low;
+            }
+            return borrow;
+        }
+
+#ifdef BIGNUMBER_X86_64_KERNELS
+        // Blocks of four chunks; the carry lives in CF (adc, sbb) or in CF and OF (adcx, adox) across the
+        // whole loop, so loop control only uses instructions that keep those flags
+
+        uint64_t add_adc(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count, uint64_t carry) {
+            const size_t head = count % 4;
+            carry = add_portable(result, lhs, rhs, head, carry);
+            size_t blocks = count / 4;
+            if (blocks == 0)
+                return carry;
+            result += head;
+            lhs += head;
+            rhs += head;
+            uint64_t t0, t1, t2, t3;
+            __asm__ volatile(
+                "neg %[carry]\n\t"
+                "1:\n\t"
+                "mov (%[lhs]), %[t0]\n\t"
+                "mov 8(%[lhs]), %[t1]\n\t"
+                "mov 16(%[lhs]), %[t2]\n\t"
+                "mov 24(%[lhs]), %[t3]\n\t"
+                "adc (%[rhs]), %[t0]\n\t"
+                "adc 8(%[rhs]), %[t1]\n\t"
+                "adc 16(%[rhs]), %[t2]\n\t"
+                "adc 24(%[rhs]), %[t3]\n\t"
+                "mov %[t0], (%[result])\n\t"
+                "mov %[t1], 8(%[result])\n\t"
+                "mov %[t2], 16(%[result])\n\t"
+                "mov %[t3], 24(%[result])\n\t"
+                "lea 32(%[lhs]), %[lhs]\n\t"
+                "lea 32(%[rhs]), %[rhs]\n\t"
+                "lea 32(%[result]), %[result]\n\t"
+                "dec %[blocks]\n\t"
+                "jnz 1b\n\t"
+                "mov $0, %k[carry]\n\t"
+                "adc $0, %k[carry]\n\t"
+                : [carry] "+&r"(carry), [blocks] "+&r"(blocks), [lhs] "+&r"(lhs), [rhs] "+&r"(rhs),
+                  [result] "+&r"(result), [t0] "=&r"(t0), [t1] "=&r"(t1), [t2] "=&r"(t2), [t3] "=&r"(t3)
+                :
+                : "cc", "memory");
+            return carry;
+        }
+
+        uint64_t subtract_sbb(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count,
+                              uint64_t borrow) {
+            const size_t head = count % 4;
+            borrow = subtract_portable(result, lhs, rhs, head, borrow);
+            size_t blocks = count / 4;
+            if (blocks == 0)
+                return borrow;
+            result += head;
+            lhs += head;
+            rhs += head;
+            uint64_t t0, t1, t2, t3;
+            __asm__ volatile(
+                "neg %[borrow]\n\t"
+                "1:\n\t"
+                "mov (%[lhs]), %[t0]\n\t"
+                "mov 8(%[lhs]), %[t1]\n\t"
+                "mov 16(%[lhs]), %[t2]\n\t"
+                "mov 24(%[lhs]), %[t3]\n\t"
+                "sbb (%[rhs]), %[t0]\n\t"
+                "sbb 8(%[rhs]), %[t1]\n\t"
+                "sbb 16(%[rhs]), %[t2]\n\t"
+                "sbb 24(%[rhs]), %[t3]\n\t"
+                "mov %[t0], (%[result])\n\t"
+                "mov %[t1], 8(%[result])\n\t"
+                "mov %[t2], 16(%[result])\n\t"
+                "mov %[t3], 24(%[result])\n\t"
+                "lea 32(%[lhs]), %[lhs]\n\t"
+                "lea 32(%[rhs]), %[rhs]\n\t"
+                "lea 32(%[result]), %[result]\n\t"
+                "dec %[blocks]\n\t"
+                "jnz 1b\n\t"
+                "mov $0, %k[borrow]\n\t"
+                "adc $0, %k[borrow]\n\t"
+                : [borrow] "+&r"(borrow), [blocks] "+&r"(blocks), [lhs] "+&r"(lhs), [rhs] "+&r"(rhs),
+                  [result] "+&r"(result), [t0] "=&r"(t0), [t1] "=&r"(t1), [t2] "=&r"(t2), [t3] "=&r"(t3)
+                :
+                : "cc", "memory");
+            return borrow;
+        }
+
+        uint64_t add_multiplied_adx(uint64_t *self, const uint64_t *other, size_t count, uint64_t number) {
+            // Low halves of the products take the previous high halves on the CF chain and self on the OF chain
+            const size_t head = count % 4;
+            uint64_t carry = add_multiplied_portable(self, other, head, number, 0);
+            size_t blocks = count / 4;
+            if (blocks == 0)
+                return carry;
+            self += head;
+            other += head;
+            uint64_t low, high, zero;
+            __asm__ volatile(
+                "xor %k[zero], %k[zero]\n\t"
+                "1:\n\t"
+                "mulx (%[other]), %[low], %[high]\n\t"
+                "adcx %[carry], %[low]\n\t"
+                "adox (%[self]), %[low]\n\t"
+                "mov %[low], (%[self])\n\t"
+                "mulx 8(%[other]), %[low], %[carry]\n\t"
+                "adcx %[high], %[low]\n\t"
+                "adox 8(%[self]), %[low]\n\t"
+                "mov %[low], 8(%[self])\n\t"
+                "mulx 16(%[other]), %[low], %[high]\n\t"
+                "adcx %[carry], %[low]\n\t"
+                "adox 16(%[self]), %[low]\n\t"
+                "mov %[low], 16(%[self])\n\t"
+                "mulx 24(%[other]), %[low], %[carry]\n\t"
+                "adcx %[high], %[low]\n\t"
+                "adox 24(%[self]), %[low]\n\t"
+                "mov %[low], 24(%[self])\n\t"
+                "lea 32(%[other]), %[other]\n\t"
+                "lea 32(%[self]), %[self]\n\t"
+                "lea -1(%[blocks]), %[blocks]\n\t"
+                "jrcxz 2f\n\t"
+                "jmp 1b\n\t"
+                "2:\n\t"
+                "adcx %[zero], %[carry]\n\t"
+                "adox %[zero], %[carry]\n\t"
+                : [carry] "+&r"(carry), [blocks] "+&c"(blocks), [self] "+&r"(self), [other] "+&r"(other),
+                  [low] "=&r"(low), [high] "=&r"(high), [zero] "=&r"(zero)
+                : "d"(number)
+                : "cc", "memory");
+            return carry;
+        }
+
+        uint64_t subtract_multiplied_adx(uint64_t *self, const uint64_t *other, size_t count, uint64_t number) {
+            // self - x = ~(~self + x), so the complement of self is accumulated as in add_multiplied_adx
+            const size_t head = count % 4;
+            uint64_t borrow = subtract_multiplied_portable(self, other, head, number, 0);
+            size_t blocks = count / 4;
+            if (blocks == 0)
+                return borrow;
+            self += head;
+            other += head;
+            uint64_t low, high, zero, chunk;
+            __asm__ volatile(
+                "xor %k[zero], %k[zero]\n\t"
+                "1:\n\t"
+                "mov (%[self]), %[chunk]\n\t"
+                "not %[chunk]\n\t"
+                "mulx (%[other]), %[low], %[high]\n\t"
+                "adcx %[borrow], %[low]\n\t"
+                "adox %[chunk], %[low]\n\t"
+                "not %[low]\n\t"
+                "mov %[low], (%[self])\n\t"
+                "mov 8(%[self]), %[chunk]\n\t"
+                "not %[chunk]\n\t"
+                "mulx 8(%[other]), %[low], %[borrow]\n\t"
+                "adcx %[high], %[low]\n\t"
+                "adox %[chunk], %[low]\n\t"
+                "not %[low]\n\t"
+                "mov %[low], 8(%[self])\n\t"
+                "mov 16(%[self]), %[chunk]\n\t"
+                "not %[chunk]\n\t"
+                "mulx 16(%[other]), %[low], %[high]\n\t"
+                "adcx %[borrow], %[low]\n\t"
+                "adox %[chunk], %[low]\n\t"
+                "not %[low]\n\t"
+                "mov %[low], 16(%[self])\n\t"
+                "mov 24(%[self]), %[chunk]\n\t"
+                "not %[chunk]\n\t"
+                "mulx 24(%[other]), %[low], %[borrow]\n\t"
+                "adcx %[high], %[low]\n\t"
+                "adox %[chunk], %[low]\n\t"
+                "not %[low]\n\t"
+                "mov %[low], 24(%[self])\n\t"
+                "lea 32(%[other]), %[other]\n\t"
+                "lea 32(%[self]), %[self]\n\t"
+                "lea -1(%[blocks]), %[blocks]\n\t"
+                "jrcxz 2f\n\t"
+                "jmp 1b\n\t"
+                "2:\n\t"
+                "adcx %[zero], %[borrow]\n\t"
+                "adox %[zero], %[borrow]\n\t"
+                : [borrow] "+&r"(borrow), [blocks] "+&c"(blocks), [self] "+&r"(self), [other] "+&r"(other),
+                  [low] "=&r"(low), [high] "=&r"(high), [zero] "=&r"(zero), [chunk] "=&r"(chunk)
+                : "d"(number)
+                : "cc", "memory");
+            return borrow;
+        }
+#endif
+
+        struct KernelTable {
+            uint64_t (*add)(uint64_t *, const uint64_t *, const uint64_t *, size_t, uint64_t);
+            uint64_t (*subtract)(uint64_t *, const uint64_t *, const uint64_t *, size_t, uint64_t);
+            uint64_t (*add_multiplied)(uint64_t *, const uint64_t *, size_t, uint64_t);
+            uint64_t (*subtract_multiplied)(uint64_t *, const uint64_t *, size_t, uint64_t);
+        };
+
+        uint64_t add_multiplied_fallback(uint64_t *self, const uint64_t *other, size_t count, uint64_t number) {
+            return add_multiplied_portable(self, other, count, number, 0);
+        }
+
+        uint64_t subtract_multiplied_fallback(uint64_t *self, const uint64_t *other, size_t count,
+                                              uint64_t number) {
+            return subtract_multiplied_portable(self, other, count, number, 0);
+        }
+
+        const KernelTable PORTABLE_KERNELS = {
+            add_portable, subtract_portable, add_multiplied_fallback, subtract_multiplied_fallback
+        };
+#ifdef BIGNUMBER_X86_64_KERNELS
+        const KernelTable ADC_KERNELS = { add_adc, subtract_sbb, add_multiplied_fallback, subtract_multiplied_fallback };
+        const KernelTable ADX_KERNELS = { add_adc, subtract_sbb, add_multiplied_adx, subtract_multiplied_adx };
+#endif
+
+        const KernelTable& kernel_table(LimbKernels kernels) {
+#ifdef BIGNUMBER_X86_64_KERNELS
+            if (kernels == LimbKernels::adx)
+                return ADX_KERNELS;
+            if (kernels == LimbKernels::adc)
+                return ADC_KERNELS;
+#endif
+            return PORTABLE_KERNELS;
+        }
+
+        LimbKernels detect_limb_kernels() {
+#ifdef BIGNUMBER_X86_64_KERNELS
+            // CPUID leaf 7: EBX bit 8 is BMI2 (mulx), bit 19 is ADX (adcx, adox)
+            unsigned eax, ebx, ecx, edx;
+            if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 8)) != 0 && (ebx & (1u << 19)) != 0)
+                return LimbKernels::adx;
+            return LimbKernels::adc;
+#else
+            return LimbKernels::portable;
+#endif
+        }
+
+        struct Selection {
+            LimbKernels supported = detect_limb_kernels();
+            std::atomic<LimbKernels> kernels = supported;
+            std::atomic<const KernelTable *> table = &kernel_table(supported);
+        };
+
+        Selection& selection() {
+            static Selection instance;
+            return instance;
+        }
+
+        const KernelTable& kernels() {
+            return *selection().table.load(std::memory_order_relaxed);
+        }
+    }
+
+    LimbKernels supported_limb_kernels() {
+        return selection().supported;
+    }
+
+    LimbKernels limb_kernels() {
+        return selection().kernels.load(std::memory_order_relaxed);
+    }
+
+    void set_limb_kernels(LimbKernels kernels) {
+        if (static_cast<int>(kernels) > static_cast<int>(supported_limb_kernels()))
+            throw std::runtime_error("Limb kernels are not supported by this CPU");
+        selection().kernels.store(kernels, std::memory_order_relaxed);
+        selection().table.store(&kernel_table(kernels), std::memory_order_relaxed);
+    }
+
+    uint64_t add_limbs(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count, uint64_t carry) {
+        return kernels().add(result, lhs, rhs, count, carry);
+    }
+
+    uint64_t subtract_limbs(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count,
+                            uint64_t borrow) {
+        return kernels().subtract(result, lhs, rhs, count, borrow);
+    }
+
+    uint64_t add_multiplied_limbs(uint64_t *self, const uint64_t *other, size_t count, uint64_t number) {
+        return kernels().add_multiplied(self, other, count, number);
+    }
+
+    uint64_t subtract_multiplied_limbs(uint64_t *self, const uint64_t *other, size_t count, uint64_t number) {
+        return kernels().subtract_multiplied(self, other, count, number);
+    }
+}
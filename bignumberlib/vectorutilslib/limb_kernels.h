@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace BigNumber::VectorUtils {
+
+    // Kernel sets for the chunk loops below. Portable C++ everywhere, adc uses the x86-64 adc/sbb carry chains and
+    // adx adds mulx/adcx/adox multiply-accumulate loops
+    enum class LimbKernels {
+        portable,
+        adc,
+        adx
+    };
+
+    // Best set the CPU supports, selected by CPUID at startup
+    LimbKernels supported_limb_kernels();
+    LimbKernels limb_kernels();
+    // Throws for a set the CPU does not support. Must not be changed while work is running
+    void set_limb_kernels(LimbKernels);
+
+    // Loops over count chunks, least significant first. result may be lhs or rhs but must not partially overlap
+    // them, self must not overlap other
+
+    // result = lhs + rhs + carry, returns the outgoing carry
+    uint64_t add_limbs(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count, uint64_t carry);
+    // result = lhs - rhs - borrow, returns the outgoing borrow
+    uint64_t subtract_limbs(uint64_t *result, const uint64_t *lhs, const uint64_t *rhs, size_t count,
+                            uint64_t borrow);
+    // self += other * number, returns the outgoing chunk
+    uint64_t add_multiplied_limbs(uint64_t *self, const uint64_t *other, size_t count, uint64_t number);
+    // self -= other * number, returns the chunk still to subtract above self
+    uint64_t subtract_multiplied_limbs(uint64_t *self, const uint64_t *other, size_t count, uint64_t number);
+}
@@ -0,0 +1,123 @@
+#include "memory.h"
+
+#include <algorithm>
+
+namespace BigNumber::VectorUtils {
+
+    namespace {
+        thread_local std::pmr::memory_resource *thread_resource = nullptr;
+    }
+
+    std::pmr::memory_resource *current_resource() {
+        return thread_resource != nullptr ? thread_resource : std::pmr::get_default_resource();
+    }
+
+    ScopedResource::ScopedResource(std::pmr::memory_resource *resource) : previous(thread_resource) {
+        thread_resource = resource;
+    }
+
+    ScopedResource::~ScopedResource() {
+        thread_resource = previous;
+    }
+
+    void AllocationStats::allocated(size_t bytes) {
+        ++allocations;
+        bytes_in_use += bytes;
+        peak_bytes = std::max(peak_bytes, bytes_in_use);
+    }
+
+    void AllocationStats::deallocated(size_t bytes) {
+        ++deallocations;
+        bytes_in_use -= bytes;
+    }
+
+    // Counting resource
+    CountingResource::CountingResource(std::pmr::memory_resource *upstream) : upstream(upstream) {}
+
+    const AllocationStats& CountingResource::stats() const {
+        return statistics;
+    }
+
+    void CountingResource::reset_stats() {
+        statistics = AllocationStats();
+    }
+
+    void *CountingResource::do_allocate(size_t bytes, size_t alignment) {
+        void *pointer = upstream->allocate(bytes, alignment);
+        statistics.allocated(bytes);
+        return pointer;
+    }
+
+    void CountingResource::do_deallocate(void *pointer, size_t bytes, size_t alignment) {
+        upstream->deallocate(pointer, bytes, alignment);
+        statistics.deallocated(bytes);
+    }
+
+    bool CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    // Arena
+    ChunkArena::ChunkArena(size_t initial_size, std::pmr::memory_resource *upstream)
+        : upstream(upstream), arena(initial_size, &this->upstream) {}
+
+    void ChunkArena::release() {
+        arena.release();
+        statistics.bytes_in_use = 0;
+    }
+
+    const AllocationStats& ChunkArena::stats() const {
+        return statistics;
+    }
+
+    const AllocationStats& ChunkArena::upstream_stats() const {
+        return upstream.stats();
+    }
+
+    void *ChunkArena::do_allocate(size_t bytes, size_t alignment) {
+        void *pointer = arena.allocate(bytes, alignment);
+        statistics.allocated(bytes);
+        return pointer;
+    }
+
+    void ChunkArena::do_deallocate(void *pointer, size_t bytes, size_t alignment) {
+        arena.deallocate(pointer, bytes, alignment);
+        statistics.deallocated(bytes);
+    }
+
+    bool ChunkArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+
+    // Pool
+    ChunkPool::ChunkPool(std::pmr::memory_resource *upstream)
+        : upstream(upstream), pool(&this->upstream) {}
+
+    void ChunkPool::release() {
+        pool.release();
+        statistics.bytes_in_use = 0;
+    }
+
+    const AllocationStats& ChunkPool::stats() const {
+        return statistics;
+    }
+
+    const AllocationStats& ChunkPool::upstream_stats() const {
+        return upstream.stats();
+    }
+
+    void *ChunkPool::do_allocate(size_t bytes, size_t alignment) {
+        void *pointer = pool.allocate(bytes, alignment);
+        statistics.allocated(bytes);
+        return pointer;
+    }
+
+    void ChunkPool::do_deallocate(void *pointer, size_t bytes, size_t alignment) {
+        pool.deallocate(pointer, bytes, alignment);
+        statistics.deallocated(bytes);
+    }
+
+    bool ChunkPool::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+        return this == &other;
+    }
+}
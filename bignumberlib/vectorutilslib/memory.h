@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace BigNumber::VectorUtils {
+
+    // Resource that heap chunks of this thread come from, std::pmr::get_default_resource() unless a scope is set
+    std::pmr::memory_resource *current_resource();
+
+    // Makes resource current for this thread until the scope ends. Numbers allocated inside must not
+    // outlive the resource, copy them out of the scope instead of moving them
+    class ScopedResource {
+     public:
+        explicit ScopedResource(std::pmr::memory_resource *);
+        ~ScopedResource();
+        ScopedResource(const ScopedResource&) = delete;
+        ScopedResource& operator=(const ScopedResource&) = delete;
+
+     private:
+        std::pmr::memory_resource *previous;
+    };
+
+    struct AllocationStats {
+        uint64_t allocations = 0;
+        uint64_t deallocations = 0;
+        uint64_t bytes_in_use = 0;
+        uint64_t peak_bytes = 0;
+
+        void allocated(size_t);
+        void deallocated(size_t);
+    };
+
+    // Forwards to upstream and counts what passes through
+    class CountingResource : public std::pmr::memory_resource {
+     public:
+        explicit CountingResource(std::pmr::memory_resource * = std::pmr::get_default_resource());
+
+        [[nodiscard]] const AllocationStats& stats() const;
+        void reset_stats();
+
+     private:
+        std::pmr::memory_resource *upstream;
+        AllocationStats statistics;
+
+        void *do_allocate(size_t, size_t) override;
+        void do_deallocate(void *, size_t, size_t) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+    };
+
+    // Monotonic arena, deallocation is a no-op and everything is released in bulk
+    class ChunkArena : public std::pmr::memory_resource {
+     public:
+        explicit ChunkArena(size_t = 1 << 16, std::pmr::memory_resource * = std::pmr::get_default_resource());
+
+        void release();
+        // Requests served by the arena and blocks it took from upstream
+        [[nodiscard]] const AllocationStats& stats() const;
+        [[nodiscard]] const AllocationStats& upstream_stats() const;
+
+     private:
+        CountingResource upstream;
+        std::pmr::monotonic_buffer_resource arena;
+        AllocationStats statistics;
+
+        void *do_allocate(size_t, size_t) override;
+        void do_deallocate(void *, size_t, size_t) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+    };
+
+    // Pool of size classes that reuses freed chunks, single threaded
+    class ChunkPool : public std::pmr::memory_resource {
+     public:
+        explicit ChunkPool(std::pmr::memory_resource * = std::pmr::get_default_resource());
+
+        void release();
+        // Requests served by the pool and blocks it took from upstream
+        [[nodiscard]] const AllocationStats& stats() const;
+        [[nodiscard]] const AllocationStats& upstream_stats() const;
+
+     private:
+        CountingResource upstream;
+        std::pmr::unsynchronized_pool_resource pool;
+        AllocationStats statistics;
+
+        void *do_allocate(size_t, size_t) override;
+        void do_deallocate(void *, size_t, size_t) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource&) const noexcept override;
+    };
+}
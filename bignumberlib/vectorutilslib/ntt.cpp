@@ -0,0 +1,210 @@
+#include "vector_utils.h"
+
+namespace BigNumber::VectorUtils {
+
+    namespace {
+        // Primes c * 2^42 + 1 below 2^62 and their primitive roots,
+        // the product exceeds any convolution coefficient of 2^58 chunks
+        const uint64_t PRIMES[3] = { 0x3FFF'C000'0000'0001, 0x3FFF'8400'0000'0001, 0x3FFF'5400'0000'0001 };
+        const uint64_t ROOTS[3] = { 11, 19, 5 };
+
+        class MontgomeryField {
+         public:
+            uint64_t prime;
+            uint64_t prime_inverse; // -prime^(-1) mod 2^64
+            uint64_t r_squared;     // 2^128 mod prime
+
+            explicit MontgomeryField(uint64_t p) : prime(p) {
+                uint64_t inverse = p;
+                for (size_t i = 0; i < 5; ++i)
+                    inverse *= 2 - p * inverse;
+                prime_inverse = -inverse;
+                const __uint128_t r = (static_cast<__uint128_t>(1) << 64) % p;
+                r_squared = static_cast<uint64_t>((r * r) % p);
+            }
+
+            [[nodiscard]] uint64_t multiply(uint64_t lhs, uint64_t rhs) const {
+                const __uint128_t product = static_cast<__uint128_t>(lhs) * rhs;
+                const uint64_t m = static_cast<uint64_t>(product) * prime_inverse;
+                const __uint128_t reduced = (product + static_cast<__uint128_t>(m) * prime) >> 64;
+                const uint64_t result = static_cast<uint64_t>(reduced);
+                return result >= prime ? result - prime : result;
+            }
+
+            [[nodiscard]] uint64_t add(uint64_t lhs, uint64_t rhs) const {
+                const uint64_t result = lhs + rhs;
+                return result >= prime ? result - prime : result;
+            }
+
+            [[nodiscard]] uint64_t subtract(uint64_t lhs, uint64_t rhs) const {
+                return lhs >= rhs ? lhs - rhs : lhs + prime - rhs;
+            }
+
+            [[nodiscard]] uint64_t to_montgomery(uint64_t number) const {
+                return multiply(number % prime, r_squared);
+            }
+
+            [[nodiscard]] uint64_t power(uint64_t base, uint64_t exponent) const {
+                // base and result are in Montgomery form
+                uint64_t result = to_montgomery(1);
+                while (exponent > 0) {
+                    if (exponent & 1)
+                        result = multiply(result, base);
+                    base = multiply(base, base);
+                    exponent >>= 1;
+                }
+                return result;
+            }
+        };
+
+        std::pmr::vector<uint64_t> twiddles(const MontgomeryField& field, uint64_t root, uint64_t length) {
+            // Powers of the primitive length-th root of unity in Montgomery form
+            std::pmr::vector<uint64_t> result(std::max<uint64_t>(length >> 1, 1), current_resource());
+            const uint64_t step = field.power(field.to_montgomery(root), (field.prime - 1) / length);
+            result[0] = field.to_montgomery(1);
+            for (size_t i = 1; i < result.size(); ++i)
+                result[i] = field.multiply(result[i - 1], step);
+            return result;
+        }
+
+        void forward_transform(std::pmr::vector<uint64_t>& self, const MontgomeryField& field,
+                               const std::pmr::vector<uint64_t>& roots) {
+            // Decimation in frequency, natural order in, bit-reversed order out
+            const uint64_t length = self.size();
+            for (uint64_t half = length >> 1, stride = 1; half > 0; half >>= 1, stride <<= 1) {
+                for (uint64_t block = 0; block < length; block += half << 1) {
+                    for (uint64_t j = 0; j < half; ++j) {
+                        const uint64_t u = self[block + j];
+                        const uint64_t v = self[block + j + half];
+                        self[block + j] = field.add(u, v);
+                        self[block + j + half] = field.multiply(field.subtract(u, v), roots[j * stride]);
+                    }
+                }
+            }
+        }
+
+        void inverse_transform(std::pmr::vector<uint64_t>& self, const MontgomeryField& field,
+                               const std::pmr::vector<uint64_t>& roots) {
+            // Decimation in time with inverse roots, bit-reversed order in, natural order out
+            const uint64_t length = self.size();
+            for (uint64_t half = 1, stride = length >> 1; half < length; half <<= 1, stride >>= 1) {
+                for (uint64_t block = 0; block < length; block += half << 1) {
+                    const uint64_t u = self[block];
+                    const uint64_t v = self[block + half];
+                    self[block] = field.add(u, v);
+                    self[block + half] = field.subtract(u, v);
+                    for (uint64_t j = 1; j < half; ++j) {
+                        // w^(-j * stride) = -w^(length / 2 - j * stride)
+                        const uint64_t u = self[block + j];
+                        const uint64_t t = field.multiply(self[block + j + half], roots[(length >> 1) - j * stride]);
+                        self[block + j] = field.subtract(u, t);
+                        self[block + j + half] = field.add(u, t);
+                    }
+                }
+            }
+        }
+
+        std::pmr::vector<uint64_t> convolution(const ChunkVector& lhs, const ChunkVector& rhs,
+                                          uint64_t length, size_t index, bool parallel) {
+            // Cyclic convolution of lhs and rhs modulo PRIMES[index], forward transforms in parallel if asked
+            const MontgomeryField field(PRIMES[index]);
+            const std::pmr::vector<uint64_t> roots = twiddles(field, ROOTS[index], length);
+            std::pmr::vector<uint64_t> lhs_image(length, 0, current_resource());
+            std::pmr::vector<uint64_t> rhs_image(current_resource());
+            const auto transform_lhs = [&] {
+                for (size_t i = 0; i < lhs.size(); ++i)
+                    lhs_image[i] = lhs[i] % field.prime;
+                forward_transform(lhs_image, field, roots);
+            };
+            // A square transforms its operand once
+            const auto transform_rhs = [&] {
+                rhs_image.resize(length, 0);
+                for (size_t i = 0; i < rhs.size(); ++i)
+                    rhs_image[i] = rhs[i] % field.prime;
+                forward_transform(rhs_image, field, roots);
+            };
+            if (&lhs == &rhs) {
+                transform_lhs();
+            } else if (parallel) {
+                fork_join(transform_lhs, transform_rhs);
+            } else {
+                transform_lhs();
+                transform_rhs();
+            }
+            const std::pmr::vector<uint64_t>& rhs_values = (&lhs == &rhs) ? lhs_image : rhs_image;
+            // Montgomery products carry a 2^-64 factor, compensate it together with 1 / length
+            const uint64_t r = static_cast<uint64_t>((static_cast<__uint128_t>(1) << 64) % field.prime);
+            const uint64_t length_inverse = field.power(field.to_montgomery(length), field.prime - 2);
+            const uint64_t scale = field.multiply(length_inverse, field.to_montgomery(r));
+            for (size_t i = 0; i < length; ++i)
+                lhs_image[i] = field.multiply(field.multiply(lhs_image[i], rhs_values[i]), scale);
+            inverse_transform(lhs_image, field, roots);
+            return lhs_image;
+        }
+    }
+
+    ChunkVector multiply_ntt(const ChunkVector& lhs, const ChunkVector& rhs) {
+        BIGNUMBER_INSTRUMENT(multiply_ntt, std::max(lhs.size(), rhs.size()));
+        ChunkVector result(lhs.size() + rhs.size(), 0);
+        if (lhs.empty() || rhs.empty())
+            return result;
+        uint64_t length = 1;
+        while (length < lhs.size() + rhs.size() - 1)
+            length <<= 1;
+        // The three residue convolutions are independent, large ones run in parallel
+        const bool parallel = lhs.size() + rhs.size() >= PARALLEL_MULTIPLICATION_THRESHOLD * 2;
+        std::pmr::vector<uint64_t> residues[3];
+        const auto residue = [&](size_t index) {
+            return [&, index] { residues[index] = convolution(lhs, rhs, length, index, parallel); };
+        };
+        if (parallel) {
+            fork_join(residue(0), [&] { fork_join(residue(1), residue(2)); });
+        } else {
+            for (size_t index = 0; index < 3; ++index)
+                residue(index)();
+        }
+
+        // Chinese remainder theorem recombination (Garner's algorithm)
+        const MontgomeryField second(PRIMES[1]);
+        const MontgomeryField third(PRIMES[2]);
+        // Inverses are kept in Montgomery form, so a single product yields the plain modular product
+        const uint64_t first_inverse = second.power(second.to_montgomery(PRIMES[0]), PRIMES[1] - 2);
+        const uint64_t first_modulo_third = third.to_montgomery(PRIMES[0]);
+        const uint64_t first_second_inverse = third.power(third.multiply(first_modulo_third,
+                                                                         third.to_montgomery(PRIMES[1])),
+                                                          PRIMES[2] - 2);
+        const __uint128_t first_second = static_cast<__uint128_t>(PRIMES[0]) * PRIMES[1];
+        const uint64_t first_second_low = static_cast<uint64_t>(first_second);
+        const uint64_t first_second_high = static_cast<uint64_t>(first_second >> 64);
+
+        uint64_t carry[3] = { 0, 0, 0 };
+        for (size_t i = 0; i < result.size(); ++i) {
+            if (i < lhs.size() + rhs.size() - 1) {
+                const uint64_t v1 = residues[0][i];
+                const uint64_t v2 = second.multiply(second.subtract(residues[1][i], v1 % PRIMES[1]), first_inverse);
+                const uint64_t partial = third.add(v1 % PRIMES[2], third.multiply(v2 % PRIMES[2], first_modulo_third));
+                const uint64_t v3 = third.multiply(third.subtract(residues[2][i], partial), first_second_inverse);
+                // x = v1 + p1 * v2 + p1 * p2 * v3
+                const __uint128_t middle = static_cast<__uint128_t>(PRIMES[0]) * v2;
+                const __uint128_t top_low = static_cast<__uint128_t>(first_second_low) * v3;
+                const __uint128_t top_high = static_cast<__uint128_t>(first_second_high) * v3;
+                __uint128_t sum = static_cast<__uint128_t>(carry[0]) + v1
+                                  + static_cast<uint64_t>(middle) + static_cast<uint64_t>(top_low);
+                carry[0] = static_cast<uint64_t>(sum);
+                sum = (sum >> 64) + carry[1] + static_cast<uint64_t>(middle >> 64)
+                      + static_cast<uint64_t>(top_low >> 64) + static_cast<uint64_t>(top_high);
+                carry[1] = static_cast<uint64_t>(sum);
+                carry[2] += static_cast<uint64_t>(sum >> 64) + static_cast<uint64_t>(top_high >> 64);
+            }
+            result[i] = carry[0];
+            carry[0] = carry[1];
+            carry[1] = carry[2];
+            carry[2] = 0;
+        }
+        return result;
+    }
+
+    ChunkVector square_ntt(const ChunkVector& self) {
+        return multiply_ntt(self, self);
+    }
+}
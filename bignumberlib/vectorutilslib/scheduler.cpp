@@ -0,0 +1,230 @@
+#include "scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BigNumber::VectorUtils {
+
+    namespace {
+        // Threads that work forked by this thread may use, 0 when not limited
+        thread_local size_t thread_budget = 0;
+
+        struct Task {
+            const std::function<void()>& work;
+            size_t budget;
+            std::exception_ptr error;
+            std::atomic<bool> done = false;
+
+            void run() {
+                const size_t previous = thread_budget;
+                thread_budget = budget;
+                try {
+                    work();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                thread_budget = previous;
+                done.store(true, std::memory_order_release);
+            }
+        };
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task *> tasks;
+        };
+
+        // Queue of the worker running on this thread
+        thread_local size_t worker_index = SIZE_MAX;
+
+        class Scheduler {
+         public:
+            ~Scheduler() {
+                stop();
+            }
+
+            void resize(size_t count) {
+                stop();
+                threads = std::max<size_t>(count, 1);
+            }
+
+            [[nodiscard]] size_t size() const {
+                return threads;
+            }
+
+            void fork_join(const std::function<void()>& left, const std::function<void()>& right) {
+                const size_t budget = thread_budget != 0 ? std::min(thread_budget, threads) : threads;
+                if (budget <= 1) {
+                    left();
+                    right();
+                    return;
+                }
+                start();
+                Task task{ right, budget / 2, nullptr };
+                const size_t index = own_queue();
+                push(index, &task);
+                std::exception_ptr error;
+                const size_t previous = thread_budget;
+                thread_budget = budget - budget / 2;
+                try {
+                    left();
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                thread_budget = previous;
+                if (take_back(index, &task)) {
+                    task.run();
+                } else {
+                    // Stolen, help with other work until it is done
+                    while (!task.done.load(std::memory_order_acquire)) {
+                        if (Task *other = take(index))
+                            other->run();
+                        else
+                            std::this_thread::yield();
+                    }
+                }
+                if (error)
+                    std::rethrow_exception(error);
+                if (task.error)
+                    std::rethrow_exception(task.error);
+            }
+
+         private:
+            size_t threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+            std::vector<std::thread> workers;
+            // One queue per worker and a last one shared by threads outside the pool
+            std::vector<std::unique_ptr<Queue>> queues;
+            std::atomic<bool> started = false;
+            std::mutex start_mutex;
+            std::mutex sleep_mutex;
+            std::condition_variable wake;
+            std::atomic<size_t> pending = 0;
+            bool stopping = false;
+
+            void start() {
+                if (started.load(std::memory_order_acquire))
+                    return;
+                std::lock_guard<std::mutex> lock(start_mutex);
+                if (started.load(std::memory_order_relaxed))
+                    return;
+                for (size_t i = 0; i < threads; ++i)
+                    queues.push_back(std::make_unique<Queue>());
+                for (size_t i = 0; i + 1 < threads; ++i)
+                    workers.emplace_back([this, i] { work(i); });
+                started.store(true, std::memory_order_release);
+            }
+
+            void stop() {
+                std::lock_guard<std::mutex> lock(start_mutex);
+                {
+                    std::lock_guard<std::mutex> sleep_lock(sleep_mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (std::thread& worker : workers)
+                    worker.join();
+                workers.clear();
+                queues.clear();
+                stopping = false;
+                started.store(false, std::memory_order_release);
+            }
+
+            [[nodiscard]] size_t own_queue() const {
+                return worker_index < workers.size() ? worker_index : workers.size();
+            }
+
+            void push(size_t index, Task *task) {
+                {
+                    std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                    queues[index]->tasks.push_back(task);
+                }
+                pending.fetch_add(1, std::memory_order_release);
+                {
+                    std::lock_guard<std::mutex> lock(sleep_mutex);
+                }
+                wake.notify_one();
+            }
+
+            bool take_back(size_t index, Task *task) {
+                std::lock_guard<std::mutex> lock(queues[index]->mutex);
+                std::deque<Task *>& tasks = queues[index]->tasks;
+                const auto position = std::find(tasks.rbegin(), tasks.rend(), task);
+                if (position == tasks.rend())
+                    return false;
+                tasks.erase(std::next(position).base());
+                pending.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            Task *take(size_t index) {
+                // Newest task of the own queue, otherwise the oldest task of another one
+                for (size_t offset = 0; offset < queues.size(); ++offset) {
+                    Queue& queue = *queues[(index + offset) % queues.size()];
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    if (queue.tasks.empty())
+                        continue;
+                    Task *task;
+                    if (offset == 0) {
+                        task = queue.tasks.back();
+                        queue.tasks.pop_back();
+                    } else {
+                        task = queue.tasks.front();
+                        queue.tasks.pop_front();
+                    }
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    return task;
+                }
+                return nullptr;
+            }
+
+            void work(size_t index) {
+                worker_index = index;
+                while (true) {
+                    if (Task *task = take(index)) {
+                        task->run();
+                        continue;
+                    }
+                    std::unique_lock<std::mutex> lock(sleep_mutex);
+                    wake.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                        return stopping || pending.load(std::memory_order_acquire) > 0;
+                    });
+                    if (stopping)
+                        break;
+                }
+                worker_index = SIZE_MAX;
+            }
+        };
+
+        Scheduler& scheduler() {
+            static Scheduler instance;
+            return instance;
+        }
+    }
+
+    ScopedThreadLimit::ScopedThreadLimit(size_t count) : previous(thread_budget) {
+        thread_budget = std::max<size_t>(previous != 0 ? std::min(previous, count) : count, 1);
+    }
+
+    ScopedThreadLimit::~ScopedThreadLimit() {
+        thread_budget = previous;
+    }
+
+    void set_thread_count(size_t count) {
+        scheduler().resize(count);
+    }
+
+    size_t thread_count() {
+        return scheduler().size();
+    }
+
+    void fork_join(const std::function<void()>& left, const std::function<void()>& right) {
+        scheduler().fork_join(left, right);
+    }
+}
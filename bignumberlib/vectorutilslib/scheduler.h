@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace BigNumber::VectorUtils {
+
+    // Number of threads that evaluate forked work, the calling thread included. Defaults to the hardware
+    // concurrency, 1 runs everything on the calling thread. Must not be changed while work is running
+    void set_thread_count(size_t);
+    size_t thread_count();
+
+    // Caps the threads that work forked by this thread may use until the scope ends, 1 keeps it on this thread.
+    // The cap is split between the halves of each fork, so nested forks respect it too
+    class ScopedThreadLimit {
+     public:
+        explicit ScopedThreadLimit(size_t);
+        ~ScopedThreadLimit();
+        ScopedThreadLimit(const ScopedThreadLimit&) = delete;
+        ScopedThreadLimit& operator=(const ScopedThreadLimit&) = delete;
+
+     private:
+        size_t previous;
+    };
+
+    // Runs left and right, possibly in parallel, and returns when both are done. Work forked while waiting
+    // is picked up by idle threads (work stealing). Exceptions of either side are rethrown after both finish.
+    // Tasks on worker threads allocate from their own current_resource(), not from the forking thread's
+    void fork_join(const std::function<void()>& left, const std::function<void()>& right);
+}
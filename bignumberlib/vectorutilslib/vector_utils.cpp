@@ -1,27 +1,554 @@
 #include "vector_utils.h"
 
+#include <cmath>
+#include <deque>
+#include <string_view>
+
 namespace BigNumber::VectorUtils {
 
-    void extend(std::vector<uint64_t>& self, const std::vector<uint64_t>& other) {
+    namespace {
+        std::strong_ordering compare_magnitudes(const ChunkVector& lhs, const ChunkVector& rhs) {
+            // both vectors are trimmed
+            if (lhs.size() != rhs.size())
+                return lhs.size() <=> rhs.size();
+            return compare_vectors(lhs, rhs);
+        }
+
+        uint64_t add_chunks(ChunkVector& self, const uint64_t *other, size_t count, uint64_t offset) {
+            // self += other * (2^64)^offset over count chunks of other, carrying up through self
+            uint64_t carry = add_limbs(self.data() + offset, self.data() + offset, other, count, 0);
+            for (size_t i = offset + count; carry != 0 && i < self.size(); ++i)
+                carry = (++self[i] == 0);
+            return carry;
+        }
+
+        uint64_t subtract_chunks(ChunkVector& self, const uint64_t *other, size_t count, uint64_t offset,
+                                 uint64_t borrow) {
+            // self -= other * (2^64)^offset + borrow over count chunks of other, borrowing up through self
+            borrow = subtract_limbs(self.data() + offset, self.data() + offset, other, count, borrow);
+            for (size_t i = offset + count; borrow != 0 && i < self.size(); ++i)
+                borrow = (self[i]-- == 0);
+            return borrow;
+        }
+
+        template <typename LowChunk>
+        int64_t place_low_chunks(ChunkVector& self, uint64_t low, uint64_t possibly_nonzero, uint64_t desired,
+                                 LowChunk low_chunk) {
+            // Exact result is self * (2^64)^low plus the low chunks given by low_chunk, which are all zero when
+            // the first possibly_nonzero of them are. Truncates it as normalise_mantissa does, placing low chunks
+            // in front of self only when they are kept, and returns the exponent shift of self
+            uint64_t lowest = 0;
+            while (lowest < possibly_nonzero && low_chunk(lowest) == 0)
+                ++lowest;
+            const bool low_is_null = (lowest == possibly_nonzero);
+            uint64_t most_significant = self.size();
+            while (most_significant > 0 && self[most_significant - 1] == 0)
+                --most_significant;
+            if (most_significant != 0) {
+                most_significant += low;
+            } else if (!low_is_null) {
+                most_significant = low;
+                while (low_chunk(most_significant - 1) == 0)
+                    --most_significant;
+            } else {
+                self.resize(desired, 0);
+                return 0;
+            }
+            if (low_is_null) {
+                lowest = low;
+                while (self[lowest - low] == 0)
+                    ++lowest;
+            }
+            const uint64_t shift = std::max(most_significant > desired ? most_significant - desired : 0, lowest);
+            if (shift >= low) {
+                shift_left(self, shift - low);
+                self.resize(desired, 0);
+                return static_cast<int64_t>(shift - low);
+            }
+            self.insert(self.begin(), low - shift, 0);
+            for (uint64_t i = shift; i < low; ++i)
+                self[i - shift] = low_chunk(i);
+            self.resize(desired, 0);
+            return static_cast<int64_t>(shift) - static_cast<int64_t>(low);
+        }
+
+        ChunkVector add_vectors(const ChunkVector& lhs, const ChunkVector& rhs) {
+            ChunkVector result = lhs.size() >= rhs.size() ? lhs : rhs;
+            result.push_back(0);
+            add_vector_at(result, lhs.size() >= rhs.size() ? rhs : lhs, 0);
+            return trimmed(result);
+        }
+
+        SignedVector square_signed(const SignedVector& self) {
+            return { trimmed(square_vector(self.magnitude)), false };
+        }
+
+        void shift_bits_left(ChunkVector& self, uint64_t shift) {
+            // 0 < shift < 64
+            uint64_t carry = 0;
+            for (uint64_t& chunk : self) {
+                const uint64_t next_carry = chunk >> (64 - shift);
+                chunk = (chunk << shift) | carry;
+                carry = next_carry;
+            }
+            if (carry != 0)
+                self.push_back(carry);
+        }
+
+        void shift_bits_right(ChunkVector& self, uint64_t shift) {
+            // 0 < shift < 64
+            uint64_t carry = 0;
+            for (int64_t i = self.size() - 1; i >= 0; --i) {
+                const uint64_t next_carry = self[i] << (64 - shift);
+                self[i] = (self[i] >> shift) | carry;
+                carry = next_carry;
+            }
+            self = trimmed(self);
+        }
+
+        ChunkVector shifted_bits_right(ChunkVector self, uint64_t shift) {
+            // Trimmed self / 2^shift
+            self.erase(self.begin(), self.begin() + static_cast<int64_t>(std::min<uint64_t>(shift / 64, self.size())));
+            if (shift % 64 != 0 && !self.empty())
+                shift_bits_right(self, shift % 64);
+            return trimmed(self);
+        }
+
+        ChunkVector shifted_bits_left(ChunkVector self, uint64_t shift) {
+            self.insert(self.begin(), shift / 64, 0);
+            if (shift % 64 != 0)
+                shift_bits_left(self, shift % 64);
+            return self;
+        }
+
+        void divide_exact_by_3(ChunkVector& self) {
+            // self is a multiple of 3, divide using the inverse of 3 modulo 2^64
+            const uint64_t inverse = 0xAAAA'AAAA'AAAA'AAAB;
+            uint64_t borrow = 0;
+            for (uint64_t& chunk : self) {
+                const uint64_t value = chunk - borrow;
+                const uint64_t underflow = chunk < borrow;
+                chunk = value * inverse;
+                const __uint128_t product = static_cast<__uint128_t>(chunk) * 3;
+                borrow = static_cast<uint64_t>(product >> 64) + underflow;
+            }
+            self = trimmed(self);
+        }
+
+        void run_tasks(bool parallel, const std::vector<std::function<void()>>& tasks, size_t first, size_t last) {
+            // Runs tasks[first, last), forking halves when parallel
+            if (last - first == 1) {
+                tasks[first]();
+                return;
+            }
+            const size_t middle = first + (last - first) / 2;
+            if (parallel) {
+                fork_join([&] { run_tasks(parallel, tasks, first, middle); },
+                          [&] { run_tasks(parallel, tasks, middle, last); });
+            } else {
+                run_tasks(parallel, tasks, first, middle);
+                run_tasks(parallel, tasks, middle, last);
+            }
+        }
+
+        void run_tasks(bool parallel, const std::vector<std::function<void()>>& tasks) {
+            if (!tasks.empty())
+                run_tasks(parallel, tasks, 0, tasks.size());
+        }
+
+        struct Toom3Points {
+            SignedVector zero;
+            SignedVector one;
+            SignedVector minus_one;
+            SignedVector minus_two;
+            SignedVector infinity;
+        };
+
+        Toom3Points evaluate_toom3(const ChunkVector& self, uint64_t part) {
+            // Values of the three parts of self as a polynomial at 0, 1, -1, -2 and infinity
+            const auto slice = [&self, part](uint64_t index) {
+                const uint64_t begin = std::min<uint64_t>(part * index, self.size());
+                const uint64_t end = std::min<uint64_t>(begin + part, self.size());
+                return trimmed(ChunkVector(self.begin() + begin, self.begin() + end));
+            };
+            const ChunkVector a0 = slice(0), a1 = slice(1), a2 = slice(2);
+            const ChunkVector a02 = add_vectors(a0, a2);
+            const SignedVector minus_one = subtract_signed({ a02, false }, { a1, false });
+            SignedVector minus_two = add_signed(minus_one, { a2, false });
+            shift_bits_left(minus_two.magnitude, 1);
+            minus_two = subtract_signed(minus_two, { a0, false });
+            return { { a0, false }, { add_vectors(a02, a1), false }, minus_one, minus_two, { a2, false } };
+        }
+
+        ChunkVector interpolate_toom3(const Toom3Points& values, uint64_t part, uint64_t size) {
+            // Coefficients of the product from its values (Bodrato's sequence), summed at part chunk steps
+            SignedVector r3 = subtract_signed(values.minus_two, values.one);
+            divide_exact_by_3(r3.magnitude);
+            SignedVector r1 = subtract_signed(values.one, values.minus_one);
+            shift_bits_right(r1.magnitude, 1);
+            SignedVector r2 = subtract_signed(values.minus_one, values.zero);
+            r3 = subtract_signed(r2, r3);
+            shift_bits_right(r3.magnitude, 1);
+            SignedVector twice_infinity = values.infinity;
+            shift_bits_left(twice_infinity.magnitude, 1);
+            r3 = add_signed(r3, twice_infinity);
+            r2 = subtract_signed(add_signed(r2, r1), values.infinity);
+            r1 = subtract_signed(r1, r3);
+
+            ChunkVector result(size, 0);
+            add_vector_at(result, values.zero.magnitude, 0);
+            add_vector_at(result, r1.magnitude, part);
+            add_vector_at(result, r2.magnitude, part * 2);
+            add_vector_at(result, r3.magnitude, part * 3);
+            add_vector_at(result, values.infinity.magnitude, part * 4);
+            return result;
+        }
+
+        struct SplitSeries {
+            SignedVector p;
+            ChunkVector q;
+            ChunkVector b;
+            SignedVector t;
+        };
+
+        ChunkVector chunks_of(__uint128_t number) {
+            return trimmed({ static_cast<uint64_t>(number), static_cast<uint64_t>(number >> 64) });
+        }
+
+        SplitSeries merge_series(const SplitSeries& left, const SplitSeries& right) {
+            // T = B_right * Q_right * T_left + B_left * P_left * T_right, products of large halves in parallel
+            const bool parallel = left.q.size() + right.q.size() >= KARATSUBA_THRESHOLD;
+            SplitSeries result;
+            SignedVector right_part;
+            run_tasks(parallel, {
+                [&] { result.t = multiply_signed({ trimmed(multiply_vectors(right.b, right.q)), false }, left.t); },
+                [&] { right_part = multiply_signed(multiply_signed({ left.b, false }, left.p), right.t); },
+                [&] { result.q = trimmed(multiply_vectors(left.q, right.q)); },
+                [&] {
+                    result.p = multiply_signed(left.p, right.p);
+                    result.b = trimmed(multiply_vectors(left.b, right.b));
+                }
+            });
+            result.t = add_signed(result.t, right_part);
+            return result;
+        }
+
+        SplitSeries split_series(const std::function<SeriesTerm(uint64_t)>& term, uint64_t first, uint64_t last) {
+            // Products of p, q and b over [first, last) and the sum T with sum = T / (B * Q)
+            if (last - first == 1) {
+                const SeriesTerm leaf = term(first);
+                const SignedVector p = { chunks_of(leaf.p), leaf.negative && leaf.p != 0 };
+                return { p, chunks_of(leaf.q), chunks_of(leaf.b),
+                         multiply_signed(p, { chunks_of(leaf.a), false }) };
+            }
+            const uint64_t middle = first + (last - first) / 2;
+            SplitSeries left;
+            SplitSeries right;
+            if (last - first >= PARALLEL_SPLIT_THRESHOLD) {
+                fork_join([&] { left = split_series(term, first, middle); },
+                          [&] { right = split_series(term, middle, last); });
+            } else {
+                left = split_series(term, first, middle);
+                right = split_series(term, middle, last);
+            }
+            return merge_series(left, right);
+        }
+
+        // Series of powers of a multi-chunk u, see split_power_series
+        struct PowerSeries {
+            SignedVector p;
+            ChunkVector q;
+            SignedVector t;
+        };
+
+        PowerSeries split_power_series(const SignedVector& u, uint64_t shift,
+                                       const std::function<__uint128_t(uint64_t)>& q, uint64_t first, uint64_t last) {
+            // sum_{first <= n < last} prod_{first <= j <= n} u / (q(j) * 2^shift) = T / (Q * 2^(shift * length))
+            // with P = u^length for length = last - first, the powers of two are kept out of Q as shifts
+            if (last - first == 1)
+                return { u, chunks_of(q(first)), u };
+            const uint64_t middle = first + (last - first) / 2;
+            PowerSeries left;
+            PowerSeries right;
+            if (last - first >= PARALLEL_SPLIT_THRESHOLD) {
+                fork_join([&] { left = split_power_series(u, shift, q, first, middle); },
+                          [&] { right = split_power_series(u, shift, q, middle, last); });
+            } else {
+                left = split_power_series(u, shift, q, first, middle);
+                right = split_power_series(u, shift, q, middle, last);
+            }
+            // T = T_left * Q_right * 2^(shift * (last - middle)) + P_left * T_right
+            const bool parallel = left.q.size() + right.q.size() >= KARATSUBA_THRESHOLD;
+            PowerSeries result;
+            SignedVector right_part;
+            run_tasks(parallel, {
+                [&] {
+                    result.t = multiply_signed(left.t, { right.q, false });
+                    result.t.magnitude = shifted_bits(result.t.magnitude,
+                                                      static_cast<int64_t>(shift * (last - middle)));
+                },
+                [&] { right_part = multiply_signed(left.p, right.t); },
+                [&] { result.q = trimmed(multiply_vectors(left.q, right.q)); },
+                [&] { result.p = multiply_signed(left.p, right.p); }
+            });
+            result.t = add_signed(result.t, right_part);
+            return result;
+        }
+
+        uint64_t power_series_terms(uint64_t bits, const std::function<double(uint64_t)>& factor_bits) {
+            // Terms until the magnitude of term n, 2^-(factor_bits(1) + ... + factor_bits(n)), falls below 2^-bits
+            uint64_t terms = 0;
+            double total = 0;
+            while (total <= static_cast<double>(bits))
+                total += factor_bits(++terms);
+            return terms;
+        }
+
+        SignedVector sum_power_series(const SignedVector& u, uint64_t shift,
+                                      const std::function<__uint128_t(uint64_t)>& q, uint64_t terms, uint64_t bits) {
+            // 2^bits * sum_{1 <= n <= terms} prod_{j <= n} u / (q(j) * 2^shift), truncated
+            if (terms == 0)
+                return { {}, false };
+            const PowerSeries sum = split_power_series(u, shift, q, 1, terms + 1);
+            ChunkVector quotient = shifted_bits(sum.t.magnitude,
+                                                static_cast<int64_t>(bits) - static_cast<int64_t>(shift * terms));
+            if (quotient.empty())
+                return { {}, false };
+            divide_vectors(quotient, sum.q);
+            quotient = trimmed(quotient);
+            return { quotient, sum.t.negative && !quotient.empty() };
+        }
+
+        ChunkVector low_bits(ChunkVector self, uint64_t bits) {
+            // self mod 2^bits
+            if (self.size() > bits / 64 + 1)
+                self.resize(bits / 64 + 1);
+            if (self.size() == bits / 64 + 1)
+                self.back() &= (uint64_t(1) << (bits % 64)) - 1;
+            return trimmed(self);
+        }
+
+        ChunkVector fixed_quotient(ChunkVector numerator, const ChunkVector& denominator, uint64_t bits) {
+            // floor(2^bits * numerator / denominator)
+            numerator = shifted_bits(numerator, static_cast<int64_t>(bits));
+            divide_vectors(numerator, denominator);
+            return trimmed(numerator);
+        }
+
+        // Constants to the most bits asked for on this thread
+        struct CachedConstant {
+            uint64_t bits = 0;
+            ChunkVector value;
+        };
+
+        ChunkVector cached_constant(CachedConstant& cache, uint64_t bits,
+                                    const std::function<ChunkVector(uint64_t)>& compute) {
+            if (cache.bits < bits) {
+                // Kept beyond any scope's resource
+                const ScopedResource scope(std::pmr::get_default_resource());
+                cache.value = compute(bits);
+                cache.bits = bits;
+            }
+            return shifted_bits_right(cache.value, cache.bits - bits);
+        }
+
+        ChunkVector atanh_inverse_sum(uint64_t k, uint64_t bits) {
+            // 2^bits * atanh(1 / k) = 2^bits * sum 1 / ((2n + 1) * k^(2n + 1)), truncated
+            const uint64_t terms = bits / (2 * (std::bit_width(k) - 1)) + 1;
+            const SeriesSum sum = sum_series([k](uint64_t n) {
+                const __uint128_t q = n == 0 ? k : static_cast<__uint128_t>(k) * k;
+                return SeriesTerm{ 1, 2 * n + 1, 1, q, false };
+            }, 0, terms);
+            return fixed_quotient(sum.numerator, sum.denominator, bits);
+        }
+
+        // Factors multiplied one by one at the leaves of a product tree
+        const uint64_t PRODUCT_LEAF_SIZE = 16;
+
+        // 10^19, the largest power of ten that fits in a chunk
+        const uint64_t DECIMAL_CHUNK = 10'000'000'000'000'000'000ull;
+        const uint64_t DECIMAL_CHUNK_DIGITS = 19;
+        // Number size (in chunks) below which decimal digits are peeled off chunk by chunk
+        const uint64_t DECIMAL_SPLIT_THRESHOLD = 32;
+
+        const ChunkVector& decimal_power(uint64_t level) {
+            // 10^(19 * 2^level), cached per thread; a deque keeps references valid while it grows
+            thread_local std::deque<ChunkVector> powers = { { DECIMAL_CHUNK } };
+            if (powers.size() <= level) {
+                // Kept beyond any scope's resource
+                const ScopedResource scope(std::pmr::get_default_resource());
+                while (powers.size() <= level)
+                    powers.push_back(trimmed(multiply_vectors(powers.back(), powers.back())));
+            }
+            return powers[level];
+        }
+
+        ChunkVector power_of_five(uint64_t exponent) {
+            // 5^27 is the largest power of five that fits in a chunk
+            if (exponent <= 27) {
+                uint64_t result = 1;
+                for (uint64_t i = 0; i < exponent; ++i)
+                    result *= 5;
+                return { result };
+            }
+            const ChunkVector half = power_of_five(exponent / 2);
+            ChunkVector result = trimmed(multiply_vectors(half, half));
+            if (exponent % 2 != 0)
+                result = trimmed(multiply_vectors(result, { 5 }));
+            return result;
+        }
+
+        ChunkVector power_of_ten(uint64_t exponent) {
+            // 10^exponent = 5^exponent * 2^exponent
+            ChunkVector result(exponent / 64, 0);
+            extend(result, power_of_five(exponent));
+            if (exponent % 64 != 0)
+                shift_bits_left(result, exponent % 64);
+            return result;
+        }
+
+        ChunkVector twice_plus_one(const ChunkVector& self) {
+            // 2 * self + 1 of a trimmed self
+            ChunkVector result = shifted_bits_left(self, 1);
+            if (result.empty())
+                result.push_back(0);
+            result[0] |= 1;
+            return result;
+        }
+
+        // Precision (in bits) up to which inverse square roots are taken from a double
+        const uint64_t INVERSE_SQRT_BASE_PRECISION = 48;
+
+        ChunkVector inverse_sqrt_approximation(const ChunkVector& number, uint64_t half_bits, uint64_t precision) {
+            // Within a few units of 2^precision / sqrt(x), x = number / 4^half_bits in [1/4, 1) and number trimmed
+            const int64_t x_shift = static_cast<int64_t>(precision) - 2 * static_cast<int64_t>(half_bits);
+            if (precision <= INVERSE_SQRT_BASE_PRECISION) {
+                // x to 64 bits
+                const ChunkVector top = shifted_bits(number, 64 - 2 * static_cast<int64_t>(half_bits));
+                const double x = std::ldexp(static_cast<double>(top[0]), -64);
+                return { static_cast<uint64_t>(std::ldexp(1 / std::sqrt(x), static_cast<int>(precision))) };
+            }
+            // Newton's iteration y + y * (1 - x * y^2) / 2 from half the precision and a few guard bits,
+            // each step doubles the correct bits
+            const uint64_t half = precision / 2 + 16;
+            const ChunkVector y = inverse_sqrt_approximation(number, half_bits, half);
+            const ChunkVector x = shifted_bits(number, x_shift);
+            // (1 - x * y^2) * 2^(precision + 2 * half)
+            const SignedVector error = subtract_signed(
+                    { power_of_two(precision + 2 * half), false },
+                    { trimmed(multiply_vectors(x, trimmed(square_vector(y)))), false });
+            // y * error / 2^(3 * half + 1), the low 2 * half - 8 bits of error change it by less than 2^-8
+            const ChunkVector correction = shifted_bits_right(
+                    multiply_vectors(y, shifted_bits_right(error.magnitude, 2 * half - 8)), half + 9);
+            return add_signed({ trimmed(shifted_bits_left(y, precision - half)), false },
+                              { correction, error.negative && !correction.empty() }).magnitude;
+        }
+
+        ChunkVector parse_decimal(std::string_view digits) {
+            // Trimmed value of a digit string, empty for zero
+            if (digits.size() <= DECIMAL_CHUNK_DIGITS * DECIMAL_SPLIT_THRESHOLD) {
+                ChunkVector result;
+                // The leading chunk takes the remainder so the others are full
+                uint64_t length = digits.size() % DECIMAL_CHUNK_DIGITS;
+                if (length == 0)
+                    length = DECIMAL_CHUNK_DIGITS;
+                for (uint64_t begin = 0; begin < digits.size(); begin += length, length = DECIMAL_CHUNK_DIGITS) {
+                    uint64_t carry = 0;
+                    uint64_t multiplier = 1;
+                    for (uint64_t i = begin; i < begin + length; ++i) {
+                        carry = carry * 10 + (digits[i] - '0');
+                        multiplier *= 10;
+                    }
+                    for (uint64_t& chunk : result) {
+                        const __uint128_t product = static_cast<__uint128_t>(chunk) * multiplier + carry;
+                        chunk = static_cast<uint64_t>(product);
+                        carry = static_cast<uint64_t>(product >> 64);
+                    }
+                    if (carry != 0)
+                        result.push_back(carry);
+                }
+                return result;
+            }
+            // Split off the lowest 19 * 2^level digits, leaving no more than that above
+            uint64_t level = 0;
+            while (DECIMAL_CHUNK_DIGITS << (level + 1) < digits.size())
+                ++level;
+            const uint64_t split = digits.size() - (DECIMAL_CHUNK_DIGITS << level);
+            const ChunkVector high = parse_decimal(digits.substr(0, split));
+            const ChunkVector low = parse_decimal(digits.substr(split));
+            if (high.empty())
+                return low;
+            return add_vectors(trimmed(multiply_vectors(high, decimal_power(level))), low);
+        }
+
+        void write_decimal(DigitWriter& writer, ChunkVector self, uint64_t level) {
+            // Writes exactly 19 * 2^level digits of a trimmed self < 10^(19 * 2^level),
+            // stops early once the writer has all the digits it takes
+            if (writer.remaining() == 0)
+                return;
+            if (self.size() < DECIMAL_SPLIT_THRESHOLD) {
+                // n chunks are less than 10^(19 * (n + 1)), the zeros above go to the writer unbuffered
+                const uint64_t size = std::min(DECIMAL_CHUNK_DIGITS << level, DECIMAL_CHUNK_DIGITS * (self.size() + 1));
+                writer.write_zeros((DECIMAL_CHUNK_DIGITS << level) - size);
+                std::string block(size, '0');
+                for (uint64_t end = block.size(); !self.empty(); end -= DECIMAL_CHUNK_DIGITS) {
+                    uint64_t chunk = modulo_vector(self, DECIMAL_CHUNK);
+                    self = trimmed(self);
+                    for (uint64_t i = end; chunk != 0; chunk /= 10)
+                        block[--i] = static_cast<char>('0' + chunk % 10);
+                }
+                writer.write_digits(block);
+                return;
+            }
+            const ChunkVector& power = decimal_power(level - 1);
+            if (compare_magnitudes(self, power) == std::strong_ordering::less) {
+                writer.write_zeros(DECIMAL_CHUNK_DIGITS << (level - 1));
+                write_decimal(writer, self, level - 1);
+                return;
+            }
+            ChunkVector remainder = divide_vectors(self, power);
+            write_decimal(writer, trimmed(self), level - 1);
+            write_decimal(writer, trimmed(remainder), level - 1);
+        }
+    }
+
+    void extend(ChunkVector& self, const ChunkVector& other) {
         self.reserve(self.size() + other.size());
         std::copy(other.begin(), other.end(), std::back_inserter(self));
     }
 
-    bool is_null(const std::vector<uint64_t>& self) {
+    bool is_null(const ChunkVector& self) {
         return std::all_of(self.begin(), self.end(), [](uint64_t elem) { return elem == 0; });
     }
 
-    void shift_left(std::vector<uint64_t>& self, uint64_t shift) {
+    ChunkVector trimmed(ChunkVector self) {
+        while (!self.empty() && self.back() == 0)
+            self.pop_back();
+        return self;
+    }
+
+    ChunkVector shifted_bits(const ChunkVector& self, int64_t shift) {
+        // Trimmed self * 2^shift, truncated
+        return shift >= 0 ? trimmed(shifted_bits_left(self, shift)) : shifted_bits_right(self, -shift);
+    }
+
+    ChunkVector power_of_two(uint64_t exponent) {
+        ChunkVector result(exponent / 64, 0);
+        result.push_back(uint64_t(1) << (exponent % 64));
+        return result;
+    }
+
+    void shift_left(ChunkVector& self, uint64_t shift) {
         std::move(self.begin() + shift, self.end(), self.begin());
         std::fill(self.end() - shift, self.end(), 0);
     }
 
-    void shift_right(std::vector<uint64_t>& self, uint64_t shift) {
+    void shift_right(ChunkVector& self, uint64_t shift) {
         std::move(self.begin(), self.end() - shift, self.begin() + shift);
         std::fill(self.begin(), self.begin() + shift, 0);
     }
 
-    void half_shift_right(std::vector<uint64_t>& self) {
+    void half_shift_right(ChunkVector& self) {
         uint64_t carry = 0;
         uint64_t next_carry;
         for (uint64_t chunk : self) {
@@ -32,7 +559,8 @@ namespace BigNumber::VectorUtils {
         }
     }
 
-    uint64_t normalise_mantissa(std::vector<uint64_t>& self, uint64_t desired) {
+    uint64_t normalise_mantissa(ChunkVector& self, uint64_t desired) {
+        BIGNUMBER_INSTRUMENT(normalise_mantissa, self.size());
         if (is_null(self))
             return 0;
         uint64_t most_significant = self.size();
@@ -57,7 +585,7 @@ namespace BigNumber::VectorUtils {
         return shift;
     }
 
-    void align_fraction_mantissa(std::vector<uint64_t>& self) {
+    void align_fraction_mantissa(ChunkVector& self) {
         uint64_t shift = 0;
         while ((1ull << (63 - shift)) > self.back())
             ++shift;
@@ -72,7 +600,7 @@ namespace BigNumber::VectorUtils {
         }
     }
 
-    std::strong_ordering compare_vectors(const std::vector<uint64_t>& self, const std::vector<uint64_t>& other) {
+    std::strong_ordering compare_vectors(const ChunkVector& self, const ChunkVector& other) {
         for (int64_t i = self.size() - 1; i >= 0; --i) {
             if (self[i] > other[i])
                 return std::strong_ordering::greater;
@@ -82,23 +610,32 @@ namespace BigNumber::VectorUtils {
         return std::strong_ordering::equal;
     }
 
-    uint64_t add_vector(std::vector<uint64_t>& self, const std::vector<uint64_t>& other) {
-        uint64_t carry = 0;
-        const uint64_t chunk_max = std::numeric_limits<uint64_t>::max();
-        for (size_t i = 0; i < self.size(); ++i) {
-            if (self[i] > (chunk_max - other[i]) || self[i] + other[i] > (chunk_max - carry)) {
-                self[i] += other[i];
-                self[i] += carry;
-                carry = 1;
-            } else {
-                self[i] += other[i] + carry;
-                carry = 0;
-            }
+    std::strong_ordering compare_mantissas(const ChunkVector& self, const ChunkVector& other, int64_t offset) {
+        // self <=> other * (2^64)^offset, compared in place from the top down
+        int64_t self_top = static_cast<int64_t>(self.size()) - 1;
+        while (self_top >= 0 && self[self_top] == 0)
+            --self_top;
+        int64_t other_top = static_cast<int64_t>(other.size()) - 1;
+        while (other_top >= 0 && other[other_top] == 0)
+            --other_top;
+        if (self_top < 0 || other_top < 0)
+            return (self_top >= 0) <=> (other_top >= 0);
+        if (self_top != other_top + offset)
+            return self_top <=> other_top + offset;
+        for (int64_t i = self_top; i >= std::min<int64_t>(0, offset); --i) {
+            const uint64_t self_chunk = i >= 0 ? self[i] : 0;
+            const uint64_t other_chunk = i >= offset ? other[i - offset] : 0;
+            if (self_chunk != other_chunk)
+                return self_chunk <=> other_chunk;
         }
-        return carry;
+        return std::strong_ordering::equal;
+    }
+
+    uint64_t add_vector(ChunkVector& self, const ChunkVector& other) {
+        return add_limbs(self.data(), self.data(), other.data(), self.size(), 0);
     }
 
-    uint64_t add_number(std::vector<uint64_t>& self, uint64_t number) {
+    uint64_t add_number(ChunkVector& self, uint64_t number) {
         const uint64_t chunk_max = std::numeric_limits<uint64_t>::max();
         uint64_t carry = (self[0] > (chunk_max - number));
         self[0] += number;
@@ -107,52 +644,258 @@ namespace BigNumber::VectorUtils {
         for (size_t i = 1; i < self.size(); ++i) {
             if (self[i] <= (chunk_max - carry)) {
                 ++self[i];
-                break;
+                return 0;
             }
             ++self[i];
-            carry = 1;
         }
         return carry;
     }
 
-    uint64_t subtract_vector(std::vector<uint64_t>& self, const std::vector<uint64_t>& other) {
-        uint64_t borrow = 0;
-        const uint64_t chunk_max = std::numeric_limits<uint64_t>::max();
-        for (size_t i = 0; i < self.size(); ++i) {
-            if (self[i] < other[i] || self[i] < other[i] + borrow) {
-                self[i] = (chunk_max - other[i]) + self[i] + 1 - borrow;
-                borrow = 1;
-            } else {
-                self[i] -= other[i] + borrow;
-                borrow = 0;
-            }
+    uint64_t subtract_vector(ChunkVector& self, const ChunkVector& other) {
+        return subtract_limbs(self.data(), self.data(), other.data(), self.size(), 0);
+    }
+
+    uint64_t add_vector_at(ChunkVector& self, const ChunkVector& other, uint64_t offset) {
+        // self += other * (2^64)^offset, other must fit in self
+        return add_chunks(self, other.data(), other.size(), offset);
+    }
+
+    uint64_t subtract_vector_at(ChunkVector& self, const ChunkVector& other, uint64_t offset) {
+        // self -= other * (2^64)^offset, other must fit in self
+        return subtract_chunks(self, other.data(), other.size(), offset, 0);
+    }
+
+    int64_t add_mantissa(ChunkVector& self, const ChunkVector& other, int64_t offset, uint64_t desired) {
+        BIGNUMBER_INSTRUMENT(add_mantissa, std::max(self.size(), other.size()));
+        // self += other * (2^64)^offset normalised to desired chunks, returns the exponent shift of self
+        if (offset >= 0) {
+            const uint64_t shift = offset;
+            if (self.size() < shift + other.size())
+                self.resize(shift + other.size(), 0);
+            if (add_vector_at(self, other, shift) != 0)
+                self.push_back(1);
+            return static_cast<int64_t>(normalise_mantissa(self, desired));
         }
-        return borrow;
-    }
-
-    std::vector<uint64_t> multiply_vectors(const std::vector<uint64_t>& lhs, const std::vector<uint64_t>& rhs) {
-        std::vector<uint64_t> result(lhs.size() + rhs.size(), 0);
-        std::vector<uint64_t> trunc_product(lhs.size() + rhs.size());
-        std::vector<uint64_t> carry(lhs.size() + rhs.size());
-        __uint128_t mul;
-        uint64_t overflow;
-        for (size_t i = 0; i < lhs.size(); ++i) {
-            std::fill(trunc_product.begin(), trunc_product.end(), 0);
-            std::fill(carry.begin(), carry.end(), 0);
-            for (size_t j = 0; j < rhs.size(); ++j) {
-                mul = static_cast<__uint128_t>(lhs[i]) * static_cast<__uint128_t>(rhs[j]);
-                overflow = static_cast<uint64_t>(mul >> 64);
-                if (overflow > 0)
-                    carry[i + j + 1] = overflow;
-                trunc_product[i + j] = static_cast<uint64_t>(mul);
-            }
-            add_vector(result, trunc_product);
-            add_vector(result, carry);
+        // Chunks of other below self are not added to anything, they are only placed if kept
+        const uint64_t low = -offset;
+        const uint64_t split = std::min<uint64_t>(low, other.size());
+        if (self.size() < other.size() - split)
+            self.resize(other.size() - split, 0);
+        if (add_chunks(self, other.data() + split, other.size() - split, 0) != 0)
+            self.push_back(1);
+        return place_low_chunks(self, low, split, desired, [&](uint64_t i) {
+            return i < split ? other[i] : uint64_t(0);
+        });
+    }
+
+    int64_t subtract_mantissa(ChunkVector& self, const ChunkVector& other, int64_t offset, uint64_t desired) {
+        BIGNUMBER_INSTRUMENT(subtract_mantissa, std::max(self.size(), other.size()));
+        // self -= other * (2^64)^offset normalised to desired chunks, self must be greater,
+        // returns the exponent shift of self
+        if (offset >= 0) {
+            const uint64_t shift = offset;
+            if (self.size() < shift + other.size())
+                self.resize(shift + other.size(), 0);
+            subtract_vector_at(self, other, shift);
+            return static_cast<int64_t>(normalise_mantissa(self, desired));
+        }
+        // Chunks below self are 0 - other, they borrow from self unless all of them are zero
+        const uint64_t low = -offset;
+        const uint64_t split = std::min<uint64_t>(low, other.size());
+        const uint64_t lowest = std::find_if(other.begin(), other.begin() + split,
+                                             [](uint64_t chunk) { return chunk != 0; }) - other.begin();
+        if (self.size() < other.size() - split)
+            self.resize(other.size() - split, 0);
+        subtract_chunks(self, other.data() + split, other.size() - split, 0, lowest < split);
+        return place_low_chunks(self, low, split, desired, [&](uint64_t i) {
+            if (lowest == split || i < lowest)
+                return uint64_t(0);
+            if (i == lowest)
+                return -other[i];
+            return ~(i < split ? other[i] : uint64_t(0));
+        });
+    }
+
+    uint64_t add_multiplied_vector(ChunkVector& self, const ChunkVector& other,
+                                   uint64_t number, uint64_t offset) {
+        // self += other * number * (2^64)^offset over other.size() chunks, returns the outgoing chunk
+        return add_multiplied_limbs(self.data() + offset, other.data(), other.size(), number);
+    }
+
+    SignedVector add_signed(const SignedVector& lhs, const SignedVector& rhs) {
+        if (lhs.negative == rhs.negative)
+            return { add_vectors(lhs.magnitude, rhs.magnitude), lhs.negative };
+        if (compare_magnitudes(lhs.magnitude, rhs.magnitude) == std::strong_ordering::less) {
+            ChunkVector result = rhs.magnitude;
+            subtract_vector_at(result, lhs.magnitude, 0);
+            return { trimmed(result), rhs.negative };
+        }
+        ChunkVector result = lhs.magnitude;
+        subtract_vector_at(result, rhs.magnitude, 0);
+        result = trimmed(result);
+        return { result, lhs.negative && !result.empty() };
+    }
+
+    SignedVector subtract_signed(const SignedVector& lhs, const SignedVector& rhs) {
+        return add_signed(lhs, { rhs.magnitude, !rhs.negative && !rhs.magnitude.empty() });
+    }
+
+    SignedVector multiply_signed(const SignedVector& lhs, const SignedVector& rhs) {
+        ChunkVector result = trimmed(multiply_vectors(lhs.magnitude, rhs.magnitude));
+        const bool negative = (lhs.negative != rhs.negative) && !result.empty();
+        return { result, negative };
+    }
+
+    ChunkVector multiply_schoolbook(const ChunkVector& lhs, const ChunkVector& rhs) {
+        ChunkVector result(lhs.size() + rhs.size(), 0);
+        for (size_t i = 0; i < rhs.size(); ++i)
+            result[i + lhs.size()] = add_multiplied_vector(result, lhs, rhs[i], i);
+        return result;
+    }
+
+    ChunkVector multiply_karatsuba(const ChunkVector& lhs, const ChunkVector& rhs) {
+        // lhs is not shorter than rhs and less than twice as long
+        const uint64_t half = lhs.size() / 2;
+        const ChunkVector lhs_low(lhs.begin(), lhs.begin() + half);
+        const ChunkVector lhs_high(lhs.begin() + half, lhs.end());
+        const ChunkVector rhs_low(rhs.begin(), rhs.begin() + half);
+        const ChunkVector rhs_high(rhs.begin() + half, rhs.end());
+        ChunkVector low, high, middle;
+        run_tasks(lhs.size() >= PARALLEL_MULTIPLICATION_THRESHOLD, {
+            [&] { low = trimmed(multiply_vectors(lhs_low, rhs_low)); },
+            [&] { high = trimmed(multiply_vectors(lhs_high, rhs_high)); },
+            [&] { middle = multiply_vectors(add_vectors(lhs_low, lhs_high), add_vectors(rhs_low, rhs_high)); }
+        });
+        subtract_vector_at(middle, low, 0);
+        subtract_vector_at(middle, high, 0);
+        ChunkVector result(lhs.size() + rhs.size(), 0);
+        add_vector_at(result, low, 0);
+        add_vector_at(result, trimmed(middle), half);
+        add_vector_at(result, high, half << 1);
+        return result;
+    }
+
+    ChunkVector multiply_toom3(const ChunkVector& lhs, const ChunkVector& rhs) {
+        // lhs is not shorter than rhs and less than twice as long
+        const uint64_t part = (lhs.size() + 2) / 3;
+        const Toom3Points a = evaluate_toom3(lhs, part);
+        const Toom3Points b = evaluate_toom3(rhs, part);
+        Toom3Points values;
+        run_tasks(lhs.size() >= PARALLEL_MULTIPLICATION_THRESHOLD, {
+            [&] { values.zero = multiply_signed(a.zero, b.zero); },
+            [&] { values.one = multiply_signed(a.one, b.one); },
+            [&] { values.minus_one = multiply_signed(a.minus_one, b.minus_one); },
+            [&] { values.minus_two = multiply_signed(a.minus_two, b.minus_two); },
+            [&] { values.infinity = multiply_signed(a.infinity, b.infinity); }
+        });
+        return interpolate_toom3(values, part, lhs.size() + rhs.size());
+    }
+
+    ChunkVector multiply_unbalanced(const ChunkVector& lhs, const ChunkVector& rhs) {
+        // lhs is at least twice as long as rhs, multiply rhs by lhs pieces of its own size
+        const uint64_t pieces = (lhs.size() + rhs.size() - 1) / rhs.size();
+        std::vector<ChunkVector> products(pieces);
+        std::vector<std::function<void()>> tasks;
+        tasks.reserve(pieces);
+        for (uint64_t i = 0; i < pieces; ++i) {
+            tasks.emplace_back([&lhs, &rhs, &products, i] {
+                const uint64_t end = std::min<uint64_t>((i + 1) * rhs.size(), lhs.size());
+                const ChunkVector piece(lhs.begin() + i * rhs.size(), lhs.begin() + end);
+                products[i] = trimmed(multiply_vectors(piece, rhs));
+            });
         }
+        run_tasks(lhs.size() >= PARALLEL_MULTIPLICATION_THRESHOLD, tasks);
+        ChunkVector result(lhs.size() + rhs.size(), 0);
+        for (uint64_t i = 0; i < pieces; ++i)
+            add_vector_at(result, products[i], i * rhs.size());
         return result;
     }
 
-    std::vector<uint64_t> modulo_vector(std::vector<uint64_t>& dividend, std::vector<uint64_t> divisor) {
+    ChunkVector square_schoolbook(const ChunkVector& self) {
+        // Products of distinct chunks are computed once and doubled, then squares of chunks are added
+        const size_t size = self.size();
+        ChunkVector result(size << 1, 0);
+        for (size_t i = 0; i + 1 < size; ++i)
+            result[i + size] = add_multiplied_limbs(result.data() + (i << 1) + 1, self.data() + i + 1, size - i - 1,
+                                                    self[i]);
+        if (size > 1)
+            shift_bits_left(result, 1);
+        uint64_t carry = 0;
+        for (size_t i = 0; i < size; ++i) {
+            const __uint128_t square = static_cast<__uint128_t>(self[i]) * self[i];
+            __uint128_t sum = static_cast<__uint128_t>(result[i << 1]) + static_cast<uint64_t>(square) + carry;
+            result[i << 1] = static_cast<uint64_t>(sum);
+            sum = static_cast<__uint128_t>(result[(i << 1) + 1]) + static_cast<uint64_t>(square >> 64)
+                  + static_cast<uint64_t>(sum >> 64);
+            result[(i << 1) + 1] = static_cast<uint64_t>(sum);
+            carry = static_cast<uint64_t>(sum >> 64);
+        }
+        return result;
+    }
+
+    ChunkVector square_karatsuba(const ChunkVector& self) {
+        const uint64_t half = self.size() / 2;
+        const ChunkVector self_low(self.begin(), self.begin() + half);
+        const ChunkVector self_high(self.begin() + half, self.end());
+        ChunkVector low, high, middle;
+        run_tasks(self.size() >= PARALLEL_MULTIPLICATION_THRESHOLD, {
+            [&] { low = trimmed(square_vector(self_low)); },
+            [&] { high = trimmed(square_vector(self_high)); },
+            [&] { middle = square_vector(add_vectors(self_low, self_high)); }
+        });
+        subtract_vector_at(middle, low, 0);
+        subtract_vector_at(middle, high, 0);
+        ChunkVector result(self.size() << 1, 0);
+        add_vector_at(result, low, 0);
+        add_vector_at(result, trimmed(middle), half);
+        add_vector_at(result, high, half << 1);
+        return result;
+    }
+
+    ChunkVector square_toom3(const ChunkVector& self) {
+        const uint64_t part = (self.size() + 2) / 3;
+        const Toom3Points a = evaluate_toom3(self, part);
+        Toom3Points values;
+        run_tasks(self.size() >= PARALLEL_MULTIPLICATION_THRESHOLD, {
+            [&] { values.zero = square_signed(a.zero); },
+            [&] { values.one = square_signed(a.one); },
+            [&] { values.minus_one = square_signed(a.minus_one); },
+            [&] { values.minus_two = square_signed(a.minus_two); },
+            [&] { values.infinity = square_signed(a.infinity); }
+        });
+        return interpolate_toom3(values, part, self.size() << 1);
+    }
+
+    ChunkVector multiply_vectors(const ChunkVector& lhs, const ChunkVector& rhs) {
+        BIGNUMBER_INSTRUMENT(multiply_vectors, std::max(lhs.size(), rhs.size()));
+        if (&lhs == &rhs)
+            return square_vector(lhs);
+        if (lhs.size() < rhs.size())
+            return multiply_vectors(rhs, lhs);
+        if (rhs.size() < KARATSUBA_THRESHOLD)
+            return multiply_schoolbook(lhs, rhs);
+        if (rhs.size() >= NTT_THRESHOLD)
+            return multiply_ntt(lhs, rhs);
+        if (lhs.size() >= rhs.size() * 2)
+            return multiply_unbalanced(lhs, rhs);
+        if (rhs.size() < TOOM3_THRESHOLD)
+            return multiply_karatsuba(lhs, rhs);
+        return multiply_toom3(lhs, rhs);
+    }
+
+    ChunkVector square_vector(const ChunkVector& self) {
+        BIGNUMBER_INSTRUMENT(square_vector, self.size());
+        if (self.size() < KARATSUBA_THRESHOLD)
+            return square_schoolbook(self);
+        if (self.size() >= NTT_THRESHOLD)
+            return square_ntt(self);
+        if (self.size() < TOOM3_THRESHOLD)
+            return square_karatsuba(self);
+        return square_toom3(self);
+    }
+
+    ChunkVector modulo_vector(ChunkVector& dividend, ChunkVector divisor) {
+        BIGNUMBER_INSTRUMENT(modulo_vector, dividend.size());
         // IMPORTANT!
         // dividend size is not less than divisor size
         // and divisor size is greater than 1
@@ -167,24 +910,16 @@ namespace BigNumber::VectorUtils {
             ++divisor_size;
         }
         const uint64_t quotient_size = dividend_size - divisor_size;
-        std::vector<uint64_t> quotient(quotient_size + 1, 0);
+        ChunkVector quotient(quotient_size + 1, 0);
         __uint128_t base = 1;
         base <<= 64;
         const __uint128_t d = base / (static_cast<__uint128_t>(divisor.back()) + 1);
-        std::vector<uint64_t> d_vec = { static_cast<uint64_t>(d) };
+        ChunkVector d_vec = { static_cast<uint64_t>(d) };
         dividend = multiply_vectors(dividend, d_vec);
         divisor = multiply_vectors(divisor, d_vec);
         divisor.resize(divisor_size);
         __uint128_t q;
         __uint128_t r;
-        std::vector<uint64_t> q_vec;
-        std::vector<uint64_t> division_complement(divisor_size + 1);
-        division_complement.back() = 1;
-        std::vector<uint64_t> division_minuend;
-        std::vector<uint64_t> division_subtrahend;
-        uint64_t borrow;
-        std::vector<uint64_t> dividend_summand;
-        std::vector<uint64_t> divisor_summand;
 
         for (int64_t i = quotient_size; i >= 0; --i) {
             q = ((static_cast<__uint128_t>(dividend[i + divisor_size]) << 64)
@@ -194,7 +929,7 @@ namespace BigNumber::VectorUtils {
                  + static_cast<__uint128_t>(dividend[i + divisor_size - 1]))
                 % divisor.back();
             do {
-                if (q == base
+                if (q >= base
                     || q * static_cast<__uint128_t>(divisor[divisor_size - 2])
                        > base * r + static_cast<__uint128_t>(dividend[i + divisor_size - 2])) {
                     --q;
@@ -203,39 +938,27 @@ namespace BigNumber::VectorUtils {
                     break;
                 }
             } while (r < base);
-            division_minuend = std::vector<uint64_t>(dividend.begin() + i, dividend.begin() + i + divisor_size + 1);
-            // q_vec = { static_cast<uint64_t>(q), static_cast<uint64_t>(q >> 64) };
-            q_vec = { static_cast<uint64_t>(q) };
-            division_subtrahend = multiply_vectors(divisor, q_vec);
-            // division_subtrahend.resize(divisor_size, 0);
-            if (compare_vectors(division_minuend, division_subtrahend) != std::strong_ordering::less) {
-                subtract_vector(division_minuend, division_subtrahend);
-                std::copy(division_minuend.begin(), division_minuend.end(), dividend.begin() + i);
-                borrow = 0;
-            } else {
-                division_minuend.push_back(0);
-                division_subtrahend.push_back(0);
-                add_vector(division_minuend, division_complement);
-                subtract_vector(division_minuend, division_subtrahend);
-                division_minuend.pop_back();
-                std::copy(division_minuend.begin(), division_minuend.end(), dividend.begin() + i);
-                borrow = 1;
-            }
+            // Subtract q * divisor in place, q is at most one too large
+            uint64_t *window = dividend.data() + i;
+            const uint64_t borrow = subtract_multiplied_limbs(window, divisor.data(), divisor_size,
+                                                              static_cast<uint64_t>(q));
+            const bool is_negative = window[divisor_size] < borrow;
+            window[divisor_size] -= borrow;
             quotient[i] = static_cast<uint64_t>(q);
-            if (borrow != 0) {
+            if (is_negative) {
                 --quotient[i];
-                dividend_summand = std::vector(dividend.begin() + i, dividend.begin() + i + divisor_size + 1);
-                divisor_summand = std::vector(divisor.begin(), divisor.end());
-                divisor_summand.push_back(0);
-                add_vector(dividend_summand, divisor_summand);
-                std::copy(dividend_summand.begin(), dividend_summand.end(), dividend.begin() + i);
+                window[divisor_size] += add_limbs(window, window, divisor.data(), divisor_size, 0);
             }
         }
 
-        std::vector<uint64_t> remainder = std::vector<uint64_t>(dividend.begin(), dividend.begin() + divisor_size);
+        ChunkVector remainder = ChunkVector(dividend.begin(), dividend.begin() + divisor_size);
 
-        for (size_t i = 0; i < divisor_size; ++i)
-            remainder[i] /= static_cast<uint64_t>(d);
+        __uint128_t remainder_carry = 0;
+        for (int64_t i = divisor_size - 1; i >= 0; --i) {
+            remainder_carry = (remainder_carry << 64) + remainder[i];
+            remainder[i] = static_cast<uint64_t>(remainder_carry / d);
+            remainder_carry %= d;
+        }
 
         if (is_size_unsatisfied)
             remainder.erase(remainder.begin());
@@ -244,56 +967,435 @@ namespace BigNumber::VectorUtils {
         return remainder;
     }
 
-    uint64_t modulo_vector(std::vector<uint64_t>& self, uint64_t divisor) {
-        // TODO: remainder is correct, quotient is not
+    ChunkVector reciprocal_vector(const ChunkVector& divisor) {
+        BIGNUMBER_INSTRUMENT(reciprocal_vector, divisor.size());
+        // divisor is trimmed and its highest bit is set,
+        // returns (2^64)^(2 * divisor.size()) / divisor truncated up to a few units
+        const uint64_t size = divisor.size();
+        ChunkVector power(size * 2 + 1, 0);
+        power.back() = 1;
+        if (size < NEWTON_DIVISION_THRESHOLD) {
+            modulo_vector(power, divisor);
+            return trimmed(power);
+        }
+        // Newton iteration X = X + X * (B^2n - D * X) / B^2n from the reciprocal of the top half
+        const uint64_t high_size = size / 2 + 2;
+        const uint64_t low_size = size - high_size;
+        const ChunkVector divisor_high(divisor.end() - static_cast<int64_t>(high_size), divisor.end());
+        const ChunkVector high_reciprocal = reciprocal_vector(divisor_high);
+        ChunkVector product = trimmed(multiply_vectors(divisor, high_reciprocal));
+        product.insert(product.begin(), low_size, 0);
+        const SignedVector error = subtract_signed({ power, false }, { product, false });
+        ChunkVector correction = trimmed(multiply_vectors(high_reciprocal, error.magnitude));
+        correction.erase(correction.begin(),
+                         correction.begin() + static_cast<int64_t>(std::min(size + high_size, correction.size())));
+        ChunkVector result(low_size, 0);
+        extend(result, high_reciprocal);
+        result.push_back(0);
+        if (error.negative) {
+            correction.push_back(0);
+            add_number(correction, 1);
+            subtract_vector_at(result, trimmed(correction), 0);
+        } else {
+            add_vector_at(result, correction, 0);
+        }
+        return trimmed(result);
+    }
+
+    ChunkVector divide_vectors(ChunkVector& dividend, ChunkVector divisor) {
+        BIGNUMBER_INSTRUMENT(divide_vectors, dividend.size());
+        // Sets dividend to the quotient and returns the remainder
+        divisor = trimmed(divisor);
+        if (compare_magnitudes(trimmed(dividend), divisor) == std::strong_ordering::less) {
+            // The quotient is zero, modulo_vector needs a dividend at least as long as the divisor
+            ChunkVector remainder = std::move(dividend);
+            dividend = ChunkVector(1, 0);
+            return remainder;
+        }
+        if (divisor.size() < NEWTON_DIVISION_THRESHOLD)
+            return modulo_vector(dividend, divisor);
+        const uint64_t dividend_size = dividend.size();
+        const uint64_t shift = std::countl_zero(divisor.back());
+        if (shift != 0) {
+            shift_bits_left(divisor, shift);
+            shift_bits_left(dividend, shift);
+        }
+        const uint64_t size = divisor.size();
+        const ChunkVector reciprocal = reciprocal_vector(divisor);
+        const uint64_t blocks = (dividend.size() + size - 1) / size;
+        dividend.resize(blocks * size, 0);
+        ChunkVector quotient(blocks * size, 0);
+        ChunkVector remainder;
+        for (int64_t block = static_cast<int64_t>(blocks) - 1; block >= 0; --block) {
+            // current = remainder * B^n + block < divisor * B^n, so its quotient fits in a block
+            ChunkVector current(dividend.begin() + block * static_cast<int64_t>(size),
+                                dividend.begin() + (block + 1) * static_cast<int64_t>(size));
+            extend(current, remainder);
+            current = trimmed(current);
+            ChunkVector estimate = trimmed(multiply_vectors(current, reciprocal));
+            estimate.erase(estimate.begin(),
+                           estimate.begin() + static_cast<int64_t>(std::min(size * 2, estimate.size())));
+            estimate.push_back(0);
+            ChunkVector product = trimmed(multiply_vectors(estimate, divisor));
+            while (compare_magnitudes(product, current) == std::strong_ordering::greater) {
+                subtract_vector_at(estimate, ChunkVector(1, 1), 0);
+                subtract_vector_at(product, divisor, 0);
+                product = trimmed(product);
+            }
+            subtract_vector_at(current, product, 0);
+            remainder = trimmed(current);
+            while (compare_magnitudes(remainder, divisor) != std::strong_ordering::less) {
+                add_number(estimate, 1);
+                subtract_vector_at(remainder, divisor, 0);
+                remainder = trimmed(remainder);
+            }
+            estimate = trimmed(estimate);
+            std::copy(estimate.begin(), estimate.end(), quotient.begin() + block * static_cast<int64_t>(size));
+        }
+        if (shift != 0 && !remainder.empty())
+            shift_bits_right(remainder, shift);
+        quotient.resize(std::max<uint64_t>(dividend_size - divisor.size() + 1, 1), 0);
+        dividend = quotient;
+        return remainder;
+    }
+
+    uint64_t reciprocal_number(uint64_t divisor) {
+        // divisor has its highest bit set, returns (2^128 - 1) / divisor - 2^64
+        return static_cast<uint64_t>(((static_cast<__uint128_t>(~divisor) << 64) | ~0ull) / divisor);
+    }
+
+    uint64_t divide_chunks(uint64_t high, uint64_t low, uint64_t divisor, uint64_t reciprocal, uint64_t& remainder) {
+        // (high * 2^64 + low) / divisor with high < divisor, divisor normalised (Moller-Granlund)
+        __uint128_t quotient = static_cast<__uint128_t>(reciprocal) * high;
+        quotient += (static_cast<__uint128_t>(high) << 64) | low;
+        uint64_t quotient_high = static_cast<uint64_t>(quotient >> 64) + 1;
+        const uint64_t quotient_low = static_cast<uint64_t>(quotient);
+        remainder = low - quotient_high * divisor;
+        if (remainder > quotient_low) {
+            --quotient_high;
+            remainder += divisor;
+        }
+        if (remainder >= divisor) {
+            ++quotient_high;
+            remainder -= divisor;
+        }
+        return quotient_high;
+    }
+
+    ChunkVector sqrt_vector(const ChunkVector& self) {
+        BIGNUMBER_INSTRUMENT(sqrt_vector, self.size());
+        // floor(sqrt(self)), trimmed. x * y and y ~ 1 / sqrt(x) to half the bits of the root are refined by one
+        // Newton step (Karp and Markstein), which needs products of half the size only. With 64 guard bits the
+        // root is within a unit, the remainder self - root^2 corrects it
+        const ChunkVector number = trimmed(self);
+        if (number.empty())
+            return {};
+        const uint64_t half_bits = (number.size() * 64 - std::countl_zero(number.back()) + 1) / 2;
+        const int64_t half = static_cast<int64_t>(half_bits + 64) / 2 + 1;
+        const int64_t x_shift = -2 * static_cast<int64_t>(half_bits);
+        const ChunkVector y = inverse_sqrt_approximation(number, half_bits, half);
+        const ChunkVector s = shifted_bits(multiply_vectors(shifted_bits(number, x_shift + half), y), -half);
+        // root * 2^(2 * half) = s * 2^half + y * (x - s^2 / 2^(2 * half)) * 2^(2 * half) / 2^(half + 1)
+        const SignedVector residual = subtract_signed({ shifted_bits(number, x_shift + 2 * half), false },
+                                                      { trimmed(square_vector(s)), false });
+        const ChunkVector correction = shifted_bits_right(multiply_vectors(y, residual.magnitude), half + 1);
+        ChunkVector root = shifted_bits(add_signed({ trimmed(shifted_bits_left(s, half)), false },
+                                                   { correction, residual.negative && !correction.empty() }).magnitude,
+                                        static_cast<int64_t>(half_bits) - 2 * half);
+        SignedVector remainder = subtract_signed({ number, false }, { trimmed(square_vector(root)), false });
+        while (remainder.negative) {
+            // self - (root - 1)^2 = remainder + 2 * (root - 1) + 1
+            subtract_vector_at(root, { 1 }, 0);
+            root = trimmed(root);
+            remainder = add_signed(remainder, { twice_plus_one(root), false });
+        }
+        for (ChunkVector step = twice_plus_one(root);
+             compare_magnitudes(remainder.magnitude, step) != std::strong_ordering::less;
+             step = twice_plus_one(root)) {
+            remainder = subtract_signed(remainder, { step, false });
+            root = add_vectors(root, { 1 });
+        }
+        return root;
+    }
+
+    ChunkVector rsqrt_vector(const ChunkVector& self, uint64_t bits) {
+        BIGNUMBER_INSTRUMENT(rsqrt_vector, self.size());
+        // floor(2^bits / sqrt(self)), trimmed, for self > 0 and bits at least half the bit length of self.
+        // The remainder 4^bits - root^2 * self corrects the approximation
+        const ChunkVector number = trimmed(self);
+        const uint64_t half_bits = (number.size() * 64 - std::countl_zero(number.back()) + 1) / 2;
+        ChunkVector root = shifted_bits_right(inverse_sqrt_approximation(number, half_bits, bits - half_bits + 64), 64);
+        SignedVector remainder = subtract_signed({ power_of_two(2 * bits), false },
+                                                 { trimmed(multiply_vectors(trimmed(square_vector(root)), number)),
+                                                   false });
+        while (remainder.negative) {
+            subtract_vector_at(root, { 1 }, 0);
+            root = trimmed(root);
+            remainder = add_signed(remainder, { trimmed(multiply_vectors(twice_plus_one(root), number)), false });
+        }
+        for (ChunkVector step = trimmed(multiply_vectors(twice_plus_one(root), number));
+             compare_magnitudes(remainder.magnitude, step) != std::strong_ordering::less;
+             step = trimmed(multiply_vectors(twice_plus_one(root), number))) {
+            remainder = subtract_signed(remainder, { step, false });
+            root = add_vectors(root, { 1 });
+        }
+        return root;
+    }
+
+    uint64_t modulo_vector(ChunkVector& self, uint64_t divisor) {
+        BIGNUMBER_INSTRUMENT(modulo_vector, self.size());
+        // Sets self to the quotient and returns the remainder
+        if (self.empty())
+            return 0;
+        const uint64_t shift = std::countl_zero(divisor);
+        const uint64_t normalised = divisor << shift;
+        const uint64_t reciprocal = reciprocal_number(normalised);
         uint64_t remainder = 0;
-        const uint64_t chunk_max = std::numeric_limits<uint64_t>::max();
-        const uint64_t mod_mul = (chunk_max - divisor + 1) % divisor; // = 2^64 mod divisor
-        uint64_t greater, less;
+        if (shift == 0) {
+            for (int64_t i = self.size() - 1; i >= 0; --i)
+                self[i] = divide_chunks(remainder, self[i], normalised, reciprocal, remainder);
+            return remainder;
+        }
+        remainder = self.back() >> (64 - shift);
         for (int64_t i = self.size() - 1; i >= 0; --i) {
-            if (self[i] > remainder * mod_mul) {
-                greater = self[i];
-                less = remainder * mod_mul;
-            } else {
-                greater = remainder * mod_mul;
-                less = self[i];
+            const uint64_t chunk = (self[i] << shift) | (i > 0 ? self[i - 1] >> (64 - shift) : 0);
+            self[i] = divide_chunks(remainder, chunk, normalised, reciprocal, remainder);
+        }
+        return remainder >> shift;
+    }
+
+    SeriesSum sum_series(const std::function<SeriesTerm(uint64_t)>& term, uint64_t first, uint64_t last) {
+        // Binary splitting over terms [first, last) with exact integers, the caller divides once
+        const SplitSeries sum = split_series(term, first, last);
+        return { sum.t.magnitude, trimmed(multiply_vectors(sum.b, sum.q)), sum.t.negative };
+    }
+
+    ChunkVector multiply_range(uint64_t first, uint64_t last, uint64_t size, uint64_t& shift) {
+        // Product of first, ..., last - 1 as a product tree, exact while it fits in size + 1 chunks and truncated
+        // beyond. Returns the trimmed product without its lowest shift chunks
+        shift = 0;
+        if (last - first <= PRODUCT_LEAF_SIZE) {
+            ChunkVector result = { 1 };
+            for (uint64_t factor = first; factor < last; ++factor) {
+                uint64_t carry = 0;
+                for (uint64_t& chunk : result) {
+                    const __uint128_t product = static_cast<__uint128_t>(chunk) * factor + carry;
+                    chunk = static_cast<uint64_t>(product);
+                    carry = static_cast<uint64_t>(product >> 64);
+                }
+                if (carry != 0)
+                    result.push_back(carry);
             }
-            self[i] = (greater / divisor + (greater % divisor + less) / divisor);
-            remainder = (greater - divisor + less) % divisor;
+            return result;
         }
-        return remainder;
+        const uint64_t middle = first + (last - first) / 2;
+        ChunkVector left;
+        ChunkVector right;
+        uint64_t left_shift;
+        uint64_t right_shift;
+        if (last - first >= PARALLEL_SPLIT_THRESHOLD) {
+            fork_join([&] { left = multiply_range(first, middle, size, left_shift); },
+                      [&] { right = multiply_range(middle, last, size, right_shift); });
+        } else {
+            left = multiply_range(first, middle, size, left_shift);
+            right = multiply_range(middle, last, size, right_shift);
+        }
+        ChunkVector result = trimmed(multiply_vectors(left, right));
+        shift = left_shift + right_shift;
+        if (result.size() > size + 1) {
+            const uint64_t excess = result.size() - size - 1;
+            result.erase(result.begin(), result.begin() + excess);
+            shift += excess;
+        }
+        return result;
     }
 
-    std::vector<uint64_t> to_integer_vector(std::string s) {
-        std::vector<uint64_t> result = { 0 };
-        std::vector<uint64_t> ten = { 10 };
-        uint64_t carry;
-        for (size_t i = 0; s[i] != '\0'; ++i) {
-            result = multiply_vectors(result, ten);
-            carry = add_number(result, s[i] - '0');
-            if (carry != 0)
-                result.push_back(1);
-            while (result.back() == 0)
-                result.pop_back();
+    ChunkVector pi_vector(uint64_t bits) {
+        // 2^bits * pi within a unit by the Chudnovsky series, 426880 * sqrt(10005) / pi =
+        // sum (6n)! * (13591409 + 545140134 * n) / ((3n)! * (n!)^3 * (-640320^3)^n), about 47 bits per term
+        thread_local CachedConstant cache;
+        return cached_constant(cache, bits, [](uint64_t bits) {
+            const uint64_t terms = (bits + 16) / 47 + 2;
+            const SeriesSum sum = sum_series([](uint64_t n) {
+                if (n == 0)
+                    return SeriesTerm{ 13591409, 1, 1, 1, false };
+                const __uint128_t p = static_cast<__uint128_t>((6 * n - 5) * (2 * n - 1)) * (6 * n - 1);
+                const __uint128_t q = static_cast<__uint128_t>(n * n * n) * 10'939'058'860'032'000ull;
+                return SeriesTerm{ 13591409 + 545140134 * n, 1, p, q, true };
+            }, 0, terms);
+            const ChunkVector root = sqrt_vector(shifted_bits({ 10005 }, 2 * static_cast<int64_t>(bits + 16)));
+            const ChunkVector numerator = multiply_vectors(multiply_vectors(root, { 426880 }), sum.denominator);
+            return shifted_bits_right(fixed_quotient(numerator, sum.numerator, 0), 16);
+        });
+    }
+
+    ChunkVector log2_vector(uint64_t bits) {
+        // 2^bits * log(2) within a unit, log(2) = 18 * atanh(1 / 26) - 2 * atanh(1 / 4801) + 8 * atanh(1 / 8749)
+        thread_local CachedConstant cache;
+        return cached_constant(cache, bits, [](uint64_t bits) {
+            ChunkVector result = multiply_vectors(atanh_inverse_sum(26, bits + 16), { 18 });
+            result = add_vectors(result, multiply_vectors(atanh_inverse_sum(8749, bits + 16), { 8 }));
+            subtract_vector_at(result, multiply_vectors(atanh_inverse_sum(4801, bits + 16), { 2 }), 0);
+            return shifted_bits_right(result, 16);
+        });
+    }
+
+    ChunkVector exp_vector(const ChunkVector& self, uint64_t bits) {
+        BIGNUMBER_INSTRUMENT(exp_vector, self.size());
+        // 2^bits * exp(x) for x = self / 2^bits in [0, 1), within a few units per 64 bits of precision.
+        // Bit-burst: x is cut into pieces u_k / 2^s_k of the fraction bits (s_(k-1), s_k] with s_k = 64 * 2^k, and
+        // exp(u_k / 2^s_k) is summed by binary splitting. Short pieces need many terms, long ones a few
+        ChunkVector result = power_of_two(bits);
+        for (uint64_t low = 0, high = std::min<uint64_t>(64, bits); low < bits;
+             low = high, high = std::min(2 * high, bits)) {
+            const ChunkVector u = low_bits(shifted_bits_right(self, bits - high), high - low);
+            if (u.empty())
+                continue;
+            const uint64_t terms = power_series_terms(bits + 8, [low](uint64_t n) {
+                return static_cast<double>(low) + std::log2(static_cast<double>(n));
+            });
+            const SignedVector sum = sum_power_series({ u, false }, high, [](uint64_t j) { return j; }, terms, bits);
+            const ChunkVector factor = add_vectors(power_of_two(bits), sum.magnitude);
+            result = shifted_bits_right(multiply_vectors(result, factor), bits);
         }
         return result;
     }
 
-    std::vector<uint64_t> to_fraction_vector(std::string s, uint64_t size) {
-        std::vector<uint64_t> result(size, 0);
-        std::vector<uint64_t> one_tenth(size, 0x9999'9999'9999'9999);
-        one_tenth.back() &= 0x1FFF'FFFF'FFFF'FFFF;
-        std::vector<uint64_t> order = one_tenth;
-        std::vector<uint64_t> digit(1);
-        std::vector<uint64_t> product;
-        for (size_t i = 0; s[i] != '\0'; ++i) {
-            digit[0] = s[i] - '0';
-            product = multiply_vectors(order, digit);
-            product.pop_back();
-            add_vector(result, product);
-            order = multiply_vectors(order, one_tenth);
-            order.erase(order.begin(), order.end() - size);
+    void sin_cos_vector(const ChunkVector& self, uint64_t bits, ChunkVector& sine, ChunkVector& cosine) {
+        BIGNUMBER_INSTRUMENT(sin_cos_vector, self.size());
+        // 2^bits * sin(x) and 2^bits * cos(x) for x = self / 2^bits in [0, 1), within a few units per 64 bits of
+        // precision. Bit-burst as in exp_vector with the angle addition formulas, for a piece v = u / 2^s
+        // sin(v) = v * sum (-u^2)^n / ((2n + 1)! * 2^(2sn)) and cos(v) = sum (-u^2)^n / ((2n)! * 2^(2sn))
+        sine = {};
+        cosine = power_of_two(bits);
+        for (uint64_t low = 0, high = std::min<uint64_t>(64, bits); low < bits;
+             low = high, high = std::min(2 * high, bits)) {
+            const ChunkVector u = low_bits(shifted_bits_right(self, bits - high), high - low);
+            if (u.empty())
+                continue;
+            const uint64_t terms = power_series_terms(bits + 8, [low](uint64_t n) {
+                return 2 * static_cast<double>(low) + std::log2(static_cast<double>((2 * n - 1) * (2 * n)));
+            });
+            const SignedVector u_square = { trimmed(square_vector(u)), true };
+            ChunkVector piece_sin;
+            ChunkVector piece_cos;
+            run_tasks(bits >= 64 * PARALLEL_MULTIPLICATION_THRESHOLD, {
+                [&] {
+                    const SignedVector sum = sum_power_series(u_square, 2 * high, [](uint64_t j) {
+                        return static_cast<__uint128_t>(2 * j) * (2 * j + 1);
+                    }, terms, bits);
+                    const ChunkVector series = add_signed({ power_of_two(bits), false }, sum).magnitude;
+                    piece_sin = shifted_bits_right(multiply_vectors(u, series), high);
+                },
+                [&] {
+                    const SignedVector sum = sum_power_series(u_square, 2 * high, [](uint64_t j) {
+                        return static_cast<__uint128_t>(2 * j - 1) * (2 * j);
+                    }, terms, bits);
+                    piece_cos = add_signed({ power_of_two(bits), false }, sum).magnitude;
+                }
+            });
+            // sin(a + b) = sin(a) cos(b) + cos(a) sin(b), cos(a + b) = cos(a) cos(b) - sin(a) sin(b), all positive
+            const ChunkVector next_sine = add_vectors(multiply_vectors(sine, piece_cos),
+                                                      multiply_vectors(cosine, piece_sin));
+            const SignedVector next_cosine = subtract_signed({ trimmed(multiply_vectors(cosine, piece_cos)), false },
+                                                             { trimmed(multiply_vectors(sine, piece_sin)), false });
+            sine = shifted_bits_right(next_sine, bits);
+            cosine = shifted_bits_right(next_cosine.magnitude, bits);
+        }
+    }
+
+    ChunkVector agm_vector(ChunkVector lhs, ChunkVector rhs) {
+        BIGNUMBER_INSTRUMENT(agm_vector, std::max(lhs.size(), rhs.size()));
+        // Arithmetic-geometric mean of integers with truncated means, until they are at most a unit apart.
+        // The difference squares from step to step once the means agree in their top bits
+        lhs = trimmed(lhs);
+        rhs = trimmed(rhs);
+        if (compare_magnitudes(lhs, rhs) == std::strong_ordering::less)
+            std::swap(lhs, rhs);
+        while (true) {
+            ChunkVector difference = lhs;
+            subtract_vector_at(difference, rhs, 0);
+            if (compare_magnitudes(trimmed(difference), { 1 }) != std::strong_ordering::greater)
+                return lhs;
+            ChunkVector mean = shifted_bits_right(add_vectors(lhs, rhs), 1);
+            rhs = sqrt_vector(multiply_vectors(lhs, rhs));
+            lhs = std::move(mean);
+        }
+    }
+
+    void write_integer_digits(DigitWriter& writer, ChunkVector self) {
+        BIGNUMBER_INSTRUMENT(to_integer_string, self.size());
+        self = trimmed(self);
+        if (self.empty()) {
+            writer.write_digits("0");
+            return;
         }
+        uint64_t level = 0;
+        while (compare_magnitudes(self, decimal_power(level)) != std::strong_ordering::less)
+            ++level;
+        writer.skip_leading_zeros();
+        write_decimal(writer, std::move(self), level);
+    }
+
+    void write_fraction_digits(DigitWriter& writer, ChunkVector self) {
+        BIGNUMBER_INSTRUMENT(to_fraction_string, self.size());
+        // Exact digits of self / B^size, none when self is null
+        if (is_null(self) || writer.remaining() == 0)
+            return;
+        const uint64_t size = self.size();
+        const auto lowest = std::find_if(self.begin(), self.end(), [](uint64_t elem) { return elem != 0; });
+        const uint64_t zero_chunks = lowest - self.begin();
+        self.erase(self.begin(), lowest);
+        const uint64_t zero_bits = std::countr_zero(self.front());
+        if (zero_bits != 0)
+            shift_bits_right(self, zero_bits);
+        // self / B^size = odd / 2^digits = odd * 5^digits / 10^digits
+        const uint64_t bits = (size - zero_chunks) * 64 - zero_bits;
+        const uint64_t digits = std::min(bits, writer.remaining());
+        // Only the leading digits when the writer takes fewer, floor(odd * 5^digits / 2^(bits - digits))
+        const ChunkVector value = shifted_bits_right(multiply_vectors(trimmed(self), power_of_five(digits)),
+                                                     bits - digits);
+        uint64_t level = 0;
+        while (DECIMAL_CHUNK_DIGITS << level < digits)
+            ++level;
+        writer.skip((DECIMAL_CHUNK_DIGITS << level) - digits);
+        write_decimal(writer, value, level);
+    }
+
+    std::string to_integer_string(ChunkVector self) {
+        std::string result;
+        DigitWriter writer([&result](std::string_view digits) { result.append(digits); });
+        write_integer_digits(writer, std::move(self));
+        writer.flush();
+        return result;
+    }
+
+    std::string to_fraction_string(ChunkVector self) {
+        // Empty when self is null
+        std::string result;
+        DigitWriter writer([&result](std::string_view digits) { result.append(digits); });
+        write_fraction_digits(writer, std::move(self));
+        writer.flush();
+        return result;
+    }
+
+    ChunkVector to_integer_vector(std::string s) {
+        BIGNUMBER_INSTRUMENT(to_integer_vector, s.size() / 19);
+        // Trimmed, empty for zero
+        return parse_decimal(s);
+    }
+
+    ChunkVector to_fraction_vector(std::string s, uint64_t size) {
+        BIGNUMBER_INSTRUMENT(to_fraction_vector, size);
+        // floor(0.s * B^size), exactly size chunks
+        ChunkVector result(size, 0);
+        extend(result, parse_decimal(s));
+        result = trimmed(result);
+        ChunkVector power = power_of_ten(s.size());
+        if (compare_magnitudes(result, power) == std::strong_ordering::less)
+            return ChunkVector(size, 0);
+        divide_vectors(result, power);
+        result.resize(size, 0);
         return result;
     }
 
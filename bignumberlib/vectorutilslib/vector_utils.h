@@ -1,26 +1,99 @@
 #pragma once
 
 #include "../big_number.h"
+#include "chunk_vector.h"
+#include "digit_writer.h"
+#include "limb_kernels.h"
+#include "scheduler.h"
 
 #include <vector>
 #include <cstdint>
+#include <functional>
 #include <string>
+#include <bit>
 
 namespace BigNumber::VectorUtils {
-    void extend(std::vector<uint64_t>&, const std::vector<uint64_t>&);
-    bool is_null(const std::vector<uint64_t>&);
-    void shift_left(std::vector<uint64_t>&, uint64_t);
-    void shift_right(std::vector<uint64_t>&, uint64_t);
-    void half_shift_right(std::vector<uint64_t>&);
-    uint64_t normalise_mantissa(std::vector<uint64_t>&, uint64_t);
-    void align_fraction_mantissa(std::vector<uint64_t>& self);
-    std::strong_ordering compare_vectors(const std::vector<uint64_t>&, const std::vector<uint64_t>&);
-    uint64_t add_vector(std::vector<uint64_t>&, const std::vector<uint64_t>&);
-    uint64_t add_number(std::vector<uint64_t>&, uint64_t);
-    uint64_t subtract_vector(std::vector<uint64_t>&, const std::vector<uint64_t>&);
-    std::vector<uint64_t> multiply_vectors(const std::vector<uint64_t>&, const std::vector<uint64_t>&);
-    uint64_t modulo_vector(std::vector<uint64_t>&, uint64_t);
-    std::vector<uint64_t> modulo_vector(std::vector<uint64_t>&, std::vector<uint64_t>);
-    std::vector<uint64_t> to_integer_vector(std::string);
-    std::vector<uint64_t> to_fraction_vector(std::string, uint64_t);
+    // Operand sizes (in chunks) from which faster multiplication algorithms are used
+    const uint64_t KARATSUBA_THRESHOLD = 64;
+    const uint64_t TOOM3_THRESHOLD = 256;
+    const uint64_t NTT_THRESHOLD = 2048;
+    // Divisor size (in chunks) from which division multiplies by a Newton reciprocal
+    const uint64_t NEWTON_DIVISION_THRESHOLD = 192;
+    // Number of series terms or product factors from which the halves of a splitting tree are evaluated in parallel
+    const uint64_t PARALLEL_SPLIT_THRESHOLD = 256;
+    // Operand size (in chunks) from which the subproducts of a multiplication are evaluated in parallel
+    const uint64_t PARALLEL_MULTIPLICATION_THRESHOLD = 1024;
+
+    // Term n of sum a(n) / b(n) * prod_{j <= n} p(j) / q(j), p(j) is negated when negative is set
+    struct SeriesTerm {
+        uint64_t a;
+        uint64_t b;
+        __uint128_t p;
+        __uint128_t q;
+        bool negative;
+    };
+
+    // Exact sum of a series as numerator / denominator
+    struct SeriesSum {
+        ChunkVector numerator;
+        ChunkVector denominator;
+        bool negative;
+    };
+
+    void extend(ChunkVector&, const ChunkVector&);
+    bool is_null(const ChunkVector&);
+    ChunkVector trimmed(ChunkVector);
+    ChunkVector shifted_bits(const ChunkVector&, int64_t);
+    ChunkVector power_of_two(uint64_t);
+    void shift_left(ChunkVector&, uint64_t);
+    void shift_right(ChunkVector&, uint64_t);
+    void half_shift_right(ChunkVector&);
+    uint64_t normalise_mantissa(ChunkVector&, uint64_t);
+    void align_fraction_mantissa(ChunkVector& self);
+    std::strong_ordering compare_vectors(const ChunkVector&, const ChunkVector&);
+    std::strong_ordering compare_mantissas(const ChunkVector&, const ChunkVector&, int64_t);
+    uint64_t add_vector(ChunkVector&, const ChunkVector&);
+    uint64_t add_number(ChunkVector&, uint64_t);
+    uint64_t subtract_vector(ChunkVector&, const ChunkVector&);
+    uint64_t add_vector_at(ChunkVector&, const ChunkVector&, uint64_t);
+    uint64_t subtract_vector_at(ChunkVector&, const ChunkVector&, uint64_t);
+    int64_t add_mantissa(ChunkVector&, const ChunkVector&, int64_t, uint64_t);
+    int64_t subtract_mantissa(ChunkVector&, const ChunkVector&, int64_t, uint64_t);
+    uint64_t add_multiplied_vector(ChunkVector&, const ChunkVector&, uint64_t, uint64_t);
+    SignedVector add_signed(const SignedVector&, const SignedVector&);
+    SignedVector subtract_signed(const SignedVector&, const SignedVector&);
+    SignedVector multiply_signed(const SignedVector&, const SignedVector&);
+    ChunkVector multiply_schoolbook(const ChunkVector&, const ChunkVector&);
+    ChunkVector multiply_karatsuba(const ChunkVector&, const ChunkVector&);
+    ChunkVector multiply_toom3(const ChunkVector&, const ChunkVector&);
+    ChunkVector multiply_ntt(const ChunkVector&, const ChunkVector&);
+    ChunkVector multiply_unbalanced(const ChunkVector&, const ChunkVector&);
+    ChunkVector multiply_vectors(const ChunkVector&, const ChunkVector&);
+    ChunkVector square_schoolbook(const ChunkVector&);
+    ChunkVector square_karatsuba(const ChunkVector&);
+    ChunkVector square_toom3(const ChunkVector&);
+    ChunkVector square_ntt(const ChunkVector&);
+    ChunkVector square_vector(const ChunkVector&);
+    uint64_t reciprocal_number(uint64_t);
+    uint64_t divide_chunks(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t&);
+    uint64_t modulo_vector(ChunkVector&, uint64_t);
+    ChunkVector modulo_vector(ChunkVector&, ChunkVector);
+    ChunkVector reciprocal_vector(const ChunkVector&);
+    ChunkVector divide_vectors(ChunkVector&, ChunkVector);
+    ChunkVector sqrt_vector(const ChunkVector&);
+    ChunkVector rsqrt_vector(const ChunkVector&, uint64_t);
+    SeriesSum sum_series(const std::function<SeriesTerm(uint64_t)>&, uint64_t, uint64_t);
+    ChunkVector multiply_range(uint64_t, uint64_t, uint64_t, uint64_t&);
+    // Fixed point numbers with the given number of fraction bits, see vector_utils.cpp for their accuracy
+    ChunkVector pi_vector(uint64_t);
+    ChunkVector log2_vector(uint64_t);
+    ChunkVector exp_vector(const ChunkVector&, uint64_t);
+    void sin_cos_vector(const ChunkVector&, uint64_t, ChunkVector&, ChunkVector&);
+    ChunkVector agm_vector(ChunkVector, ChunkVector);
+    void write_integer_digits(DigitWriter&, ChunkVector);
+    void write_fraction_digits(DigitWriter&, ChunkVector);
+    std::string to_integer_string(ChunkVector);
+    std::string to_fraction_string(ChunkVector);
+    ChunkVector to_integer_vector(std::string);
+    ChunkVector to_fraction_vector(std::string, uint64_t);
 }
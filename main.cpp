@@ -8,17 +8,13 @@ int main() {
 
     const auto start = std::chrono::high_resolution_clock::now();
 
-    BigNumber::BigNumber _1(1, precision);
     BigNumber::BigNumber _20(20, precision);
     BigNumber::BigNumber _32(32, precision);
     BigNumber::BigNumber _48(48, precision);
-    BigNumber::BigNumber _1_18 = _1 / 18;
-    BigNumber::BigNumber _1_57 = _1 / 57;
-    BigNumber::BigNumber _1_239 = _1 / 239;
 
-    BigNumber::BigNumber pi = _48 * arctan(_1_18)
-                              + _32 * arctan(_1_57)
-                              - _20 * arctan(_1_239);
+    BigNumber::BigNumber pi = _48 * BigNumber::arctan_inverse(18, precision)
+                              + _32 * BigNumber::arctan_inverse(57, precision)
+                              - _20 * BigNumber::arctan_inverse(239, precision);
 
     const auto end = std::chrono::high_resolution_clock::now();
 